@@ -0,0 +1,96 @@
+#ifndef ALLOCATORS_H
+#define ALLOCATORS_H
+
+#include "general_management.h"
+
+// The interface that my_malloc and my_free go through, one for every Allocator_Type.
+// Allocators that only differ in how they search for a free block just give p_find, 
+// and the ones that split and merge in their own way give p_malloc and p_free as well.
+typedef struct {
+    char *p_name; // Name shown in the startup prompt
+    char *p_description; // Shown next to the name in the startup prompt
+    BlockId (*p_find)(Memory *p_memory, size_t size); // Search for a free block with at least <size> bytes, NULL if p_malloc does the search
+    uint8_t (*p_malloc)(Memory *p_memory, size_t size, Pointer *p_ptr); // NULL to use p_find and then allocate()
+    void (*p_free)(Memory *p_memory, BlockId block); // NULL to merge with the free blocks next to the block
+    void (*p_init)(Memory *p_memory); // Called once on the first free block, can be NULL
+    uint8_t keeps_bins; // Boolean, if free_bins_insert and free_bins_remove should keep the free blocks in bins
+    uint8_t can_compact; // Boolean, if compact can move the blocks (buddy blocks have to stay aligned to their size)
+} Allocator;
+
+// Every allocator, by its Allocator_Type
+extern const Allocator arr_allocators[AMOUNT_OF_ALLOCATORS];
+
+// Generates a search over the linked list for a free block with at least <size> bytes, from the block <from> until the block <to> (not included).
+// STOP is a condition to return the current block right away, IS_BETTER decides if the current block replaces the best block so far,
+// both can use curr_size, best_size and size. They are known at compile time, so every policy gets its own loop without calls in it.
+#define DEFINE_LIST_FIT_SCAN(policy, STOP, IS_BETTER) \
+    BlockId policy##_scan(Memory *p_memory, size_t size, BlockId from, BlockId to) { \
+        /* Only the hot arrays are read while searching, the links are only followed to get to the next block */ \
+        size_t *p_sizes = p_memory->blocks.p_sizes; \
+        uint8_t *p_states = p_memory->blocks.p_states; \
+        BlockId *p_next = p_memory->blocks.p_next; \
+        BlockId best = NO_BLOCK; \
+        size_t best_size = 0; \
+        for (BlockId curr = from; curr != to; curr = p_next[curr]) { \
+            size_t curr_size = p_sizes[curr]; \
+            if (!(p_states[curr] & BLOCK_FREE) || curr_size < size) continue; /* Avoid double allocation and blocks that are too small */ \
+            if (STOP) return curr; \
+            if (best == NO_BLOCK || (IS_BETTER)) { \
+                best = curr; \
+                best_size = curr_size; \
+            } \
+        } \
+        (void)best_size; /* Policies that always STOP never compare sizes */ \
+        return best; \
+    }
+
+// Searches the linked list between two blocks and returns the first free block with at least <size> bytes
+//
+// Input : A pointer to the memory, the size of the allocation, the block to start from and the block to stop at (not included, NO_BLOCK for the end)
+//
+// Output : Returns the id of the first free block that fits, or NO_BLOCK
+BlockId first_fit_scan(Memory *p_memory, size_t size, BlockId from, BlockId to);
+
+// Searches the linked list between two blocks and returns the smallest free block with at least <size> bytes
+//
+// Input : A pointer to the memory, the size of the allocation, the block to start from and the block to stop at (not included, NO_BLOCK for the end)
+//
+// Output : Returns the id of the smallest free block that fits (the first one of an exact size), or NO_BLOCK
+BlockId best_fit_scan(Memory *p_memory, size_t size, BlockId from, BlockId to);
+
+// Searches the linked list between two blocks and returns the biggest free block with at least <size> bytes
+//
+// Input : A pointer to the memory, the size of the allocation, the block to start from and the block to stop at (not included, NO_BLOCK for the end)
+//
+// Output : Returns the id of the biggest free block that fits, or NO_BLOCK
+BlockId worst_fit_scan(Memory *p_memory, size_t size, BlockId from, BlockId to);
+
+// First fit policy: the first free block in memory that is big enough
+//
+// Input : A pointer to the memory and the size of the allocation
+//
+// Output : Returns the id of the free block to allocate in, or NO_BLOCK
+BlockId first_fit_find(Memory *p_memory, size_t size);
+
+// Next fit policy: the first free block that is big enough, starting from where the last search stopped and wrapping around
+//
+// Input : A pointer to the memory and the size of the allocation
+//
+// Output : Returns the id of the free block to allocate in, or NO_BLOCK. The next search starts from it
+BlockId next_fit_find(Memory *p_memory, size_t size);
+
+// Best fit policy: the smallest free block that is big enough
+//
+// Input : A pointer to the memory and the size of the allocation
+//
+// Output : Returns the id of the free block to allocate in, or NO_BLOCK
+BlockId best_fit_find(Memory *p_memory, size_t size);
+
+// Worst fit policy: the biggest free block, so the block that is left after the split is as big as possible
+//
+// Input : A pointer to the memory and the size of the allocation
+//
+// Output : Returns the id of the free block to allocate in, or NO_BLOCK
+BlockId worst_fit_find(Memory *p_memory, size_t size);
+
+#endif // ALLOCATORS_H
@@ -0,0 +1,49 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "general_management.h"
+
+// Arguments parser for the arena_create function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function arena_create if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status arena_create_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Creates an arena, a region that hands out allocations from the start of its block to its end (bump pointer)
+//
+// Input : A pointer to the memory, a name for the arena and the size of the arena in bytes
+//
+// Output : Carves one block of <size> bytes from the memory for the arena, returns a boolean (0 or 1) if it succeded or not
+uint8_t arena_create(Memory *p_memory, char *name, size_t size);
+
+// Arguments parser for the arena_alloc function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function arena_alloc if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status arena_alloc_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Allocates <size> bytes from an arena by moving its bump pointer, no block is created and no block is searched for
+//
+// Input : A pointer to the memory, a pointer to the arena, the size of the allocation, and a pointer to a pointer struct
+//
+// Output : Points <*p_ptr> at the next <size> bytes of the arena and returns 1, or returns 0 if the arena doesn't have <size> bytes left
+uint8_t arena_alloc(Memory *p_memory, Region *p_arena, size_t size, Pointer *p_ptr);
+
+// Arguments parser for the arena_reset function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function arena_reset if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status arena_reset_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Releases every allocation of an arena at once, in O(1)
+//
+// Input : A pointer to the memory and a pointer to the arena
+//
+// Output : The bump pointer goes back to the start of the arena, and the generation of the arena goes up, 
+// so every pointer that was allocated from the arena before is invalid
+void arena_reset(Memory *p_memory, Region *p_arena);
+
+#endif // ARENA_H
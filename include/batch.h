@@ -0,0 +1,50 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "general_management.h"
+
+// Arguments parser for the malloc_many function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function malloc_many if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status malloc_many_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Declares <count> pointers named <prefix>0 to <prefix><count - 1> and allocates <size> bytes for each of them,
+// with one search for a block of <count> * <size> bytes that is then split into <count> blocks in one pass
+//
+// Input : A pointer to the memory, the amount of pointers, the size of every allocation and the prefix of the names
+//
+// Output : Returns a boolean (0 or 1) if it succeded or not, if it didn't nothing was allocated and no pointer was declared
+uint8_t malloc_many(Memory *p_memory, size_t count, size_t size, char *prefix);
+
+// Splits an allocated block into allocated blocks of <size> bytes that are next to each other
+//
+// Input : A pointer to the memory, the id of an allocated block, and a size that the size of the block is a multiple of
+//
+// Output : The block is the first <size> bytes, and every <size> bytes after it are a new allocated block
+void split_into_blocks(Memory *p_memory, BlockId block, size_t size);
+
+// Arguments parser for the free_many function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function free_many if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status free_many_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Frees every pointer whose name is <prefix> followed by a number (like the ones malloc_many declares), 
+// and merges the free blocks with one sweep over the part of the memory they were in
+//
+// Input : A pointer to the memory and the prefix of the names
+//
+// Output : Returns how many pointers were freed (pointers that were not allocated, or that are from a region, are skipped)
+size_t free_many(Memory *p_memory, char *prefix);
+
+// Checks if a name is a prefix followed by a number, like the names of the pointers that malloc_many declares
+//
+// Input : A name and a prefix
+//
+// Output : Returns a boolean (0 or 1) if the name is <prefix><number> or not
+uint8_t is_batch_name(const char *name, const char *prefix);
+
+#endif // BATCH_H
@@ -0,0 +1,45 @@
+#ifndef BUDDY_H
+#define BUDDY_H
+
+#include "general_management.h"
+
+// Gets the order of the smallest buddy block that can hold <size> bytes
+//
+// Input : A size in bytes (must be more than 0)
+//
+// Output : Returns ceil(log2(size)), so a block of order k is 2^k bytes
+unsigned int buddy_order(size_t size);
+
+// Halves a block that is not in any bin, the right half becomes a new free block
+//
+// Input : A pointer to the memory and the id of a block (with a power of two size) that is not in a bin
+//
+// Output : The block keeps the left half, the right half is a new free block in its bin. 
+// Returns a boolean (0 or 1) if it succeded or not
+uint8_t buddy_split(Memory *p_memory, BlockId block);
+
+// Splits the whole memory (one free block) into the biggest power of two blocks that fit, from big to small,
+// so every block is aligned to its size, which buddy_free needs for finding the buddy of a block
+//
+// Input : A pointer to the memory, which has only one free block in it
+//
+// Output : The memory is made of free power of two blocks (one for every bit that is on in the memory size), all in the bins
+void buddy_init(Memory *p_memory);
+
+// Allocates a block of the smallest power of two that can hold <size> bytes, 
+// by taking the smallest free block that is big enough and halving it until it is the right size
+//
+// Input : A pointer to the memory, a size of allocation, and a pointer to a pointer struct
+//
+// Output : Tries to allocate 2^buddy_order(size) bytes with pointer struct <*ptr>, 
+// and returns a boolean (0 or 1) if it succeded or not
+uint8_t buddy_malloc(Memory *p_memory, size_t size, Pointer *p_ptr);
+
+// Frees a block that was allocated by buddy_malloc, and merges it with its buddy as long as the buddy is free
+//
+// Input : A pointer to the memory and the id of an allocated block
+//
+// Output : The block (merged with all of its free buddies) is free and in the bin of its order
+void buddy_free(Memory *p_memory, BlockId block);
+
+#endif // BUDDY_H
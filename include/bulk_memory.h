@@ -0,0 +1,111 @@
+#ifndef BULK_MEMORY_H
+#define BULK_MEMORY_H
+
+#include "general_management.h"
+
+// The size argument of bulk_set, bulk_copy and bulk_compare when the command was given no length:
+// all of the destination for bulk_set, all of the source for bulk_copy and the smaller of the two for bulk_compare
+#define BULK_WHOLE SIZE_MAX
+
+// Fills and copies at least this big go around the cache with streaming stores, they would push everything else out of it
+// and nothing reads them right after (smaller ones fit in the last level cache, where normal stores are faster)
+#define BULK_STREAM_SIZE ((size_t)8 << 20)
+
+// The loops that the bulk memory commands run, one for every Bulk_Kernel_Type
+typedef struct {
+    char *p_name; // Shown when the program starts
+    void (*p_fill)(uint8_t *p_dst, uint8_t value, size_t size);
+    void (*p_copy)(uint8_t *p_dst, const uint8_t *p_src, size_t size); // Also right when the two overlap (it is memmove)
+    size_t (*p_compare)(const uint8_t *p_first, const uint8_t *p_second, size_t size); // Returns the index of the first byte that differs, or size
+} Bulk_Kernels;
+
+// Every kernel, by its Bulk_Kernel_Type
+extern const Bulk_Kernels arr_bulk_kernels[AMOUNT_OF_BULK_KERNELS];
+
+// Arguments parser for the bulk_set function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function bulk_set if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status mem_set_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parser for the bulk_copy function, for ranges that don't overlap
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function bulk_copy if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status mem_copy_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parser for the bulk_copy function, for ranges that can overlap
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function bulk_copy if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status mem_move_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parser for the bulk_compare function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function bulk_compare if all the arguments are valid, prints where the bytes differ and returns how the command ended (see Command_Status)
+Command_Status mem_cmp_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Sets the first bytes a pointer points at to a value
+//
+// Input : A pointer to the memory, the pointer, the value and a pointer to how many bytes to set (BULK_WHOLE for all of them, then it is set to the amount)
+//
+// Output : Fills the bytes and marks them as written, returns a boolean (0 or 1) if it succeded or not
+uint8_t bulk_set(Memory *p_memory, Pointer dst, uint8_t value, size_t *p_size);
+
+// Copies the first bytes a pointer points at to the bytes another pointer points at
+//
+// Input : A pointer to the memory, the pointer to copy to, the pointer to copy from, a pointer to how many bytes (BULK_WHOLE for all of the source,
+// then it is set to the amount) and if the two ranges may overlap (memmove) or not (memcpy)
+//
+// Output : Copies the bytes and their bits in the shadow (garbage stays garbage), returns a boolean (0 or 1) if it succeded or not
+uint8_t bulk_copy(Memory *p_memory, Pointer dst, Pointer src, size_t *p_size, uint8_t allow_overlap);
+
+// Compares the first bytes two pointers point at
+//
+// Input : A pointer to the memory, the two pointers, a pointer to how many bytes (BULK_WHOLE for the smaller of the two, then it is set to the amount)
+// and where to put the index of the first byte that differs
+//
+// Output : Puts the index in *p_difference (the amount of bytes if they are all the same), returns a boolean (0 or 1) if it succeded or not
+uint8_t bulk_compare(Memory *p_memory, Pointer first, Pointer second, size_t *p_size, size_t *p_difference);
+
+// Parses the optional length argument of a bulk command
+//
+// Input : The argument (NULL if it was not given), where to put the length and the name of the command
+//
+// Output : Puts the length (BULK_WHOLE if there is no argument) in *p_size, returns a boolean (0 or 1) if it is valid or not
+uint8_t parse_bulk_size(const char *arg, size_t *p_size, const char *command);
+
+// Chooses the widest kernel the CPU supports, called once when the program starts
+//
+// Input : None
+//
+// Output : Returns BULK_AVX2, BULK_SSE2 or BULK_SCALAR
+Bulk_Kernel_Type select_bulk_kernels(void);
+
+// The kernels, every one of them has a fill, a copy (which can overlap, like memmove) and a compare that finds the first byte that differs
+//
+// Input : The destination and the value or the source, or the two ranges to compare, and their size
+//
+// Output : The bytes are filled or copied, or the index of the first byte that differs (or size) is returned
+
+// The scalar kernel, which calls the C library
+void fill_bytes_scalar(uint8_t *p_dst, uint8_t value, size_t size);
+void copy_bytes_scalar(uint8_t *p_dst, const uint8_t *p_src, size_t size);
+size_t compare_bytes_scalar(const uint8_t *p_first, const uint8_t *p_second, size_t size);
+
+// The SSE2 kernel, 16 bytes at a time
+void fill_bytes_sse2(uint8_t *p_dst, uint8_t value, size_t size);
+void copy_bytes_sse2(uint8_t *p_dst, const uint8_t *p_src, size_t size);
+size_t compare_bytes_sse2(const uint8_t *p_first, const uint8_t *p_second, size_t size);
+
+// The AVX2 kernel, 32 bytes at a time
+void fill_bytes_avx2(uint8_t *p_dst, uint8_t value, size_t size);
+void copy_bytes_avx2(uint8_t *p_dst, const uint8_t *p_src, size_t size);
+size_t compare_bytes_avx2(const uint8_t *p_first, const uint8_t *p_second, size_t size);
+
+#endif // BULK_MEMORY_H
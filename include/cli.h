@@ -8,7 +8,7 @@
 
 // Defining different types of commands based on what the parser they correspond to needs
 typedef void (*Command_Func)(int, char**);
-typedef void (*Memo_Command_Func)(Memory*, int, char**);
+typedef Command_Status (*Memo_Command_Func)(Memory*, int, char**);
 typedef void (*Hashmap_Command_Func)(HashMap*, int, char**);
 typedef void (*ALL_Command_Func)(Memory*, HashMap*, int, char**);
 
@@ -30,6 +30,7 @@ struct Command {
         ALL_Command_Func ALL_cmd;
     };
     size_t amount_of_arguments;
+    size_t amount_of_optional_arguments; // Arguments after the required ones that can be left out, 0 for most commands
     Command_Classification type_of_function;
 };
 
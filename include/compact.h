@@ -0,0 +1,29 @@
+#ifndef COMPACT_H
+#define COMPACT_H
+
+#include "general_management.h"
+
+// Arguments parser for the compact function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function compact if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status compact_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Slides every allocated block towards index 0 so all the free bytes become one block at the end of the memory.
+// Pointers are indexes into the bytes array, so every pointer in memory->p_pointers is moved along with its block
+//
+// Input : A pointer to the memory
+//
+// Output : The allocated blocks (and their bytes) are next to each other from index 0, followed by one free block with all the free bytes,
+// returns a boolean (0 or 1) if it succeded or not
+uint8_t compact(Memory *p_memory);
+
+// Moves every pointer in memory->p_pointers to where its block will start after compaction
+//
+// Input : A pointer to the memory and the new start index of every allocated block (by its id)
+//
+// Output : Every pointer keeps its offset inside its block (pointers into a region are somewhere inside the region's block)
+void relocate_pointers(Memory *p_memory, size_t *p_new_starts);
+
+#endif // COMPACT_H
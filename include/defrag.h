@@ -0,0 +1,36 @@
+#ifndef DEFRAG_H
+#define DEFRAG_H
+
+#include "general_management.h"
+
+// Arguments parser for the set_defrag_budget function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function set_defrag_budget if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status defrag_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Turns the incremental defragmentation on (or off), it moves at most <budget> bytes after every command
+//
+// Input : A pointer to the memory and how many bytes a step may move (0 turns it off)
+//
+// Output : Saves the budget in memory->defrag_budget, returns a boolean (0 or 1) if it succeded or not
+uint8_t set_defrag_budget(Memory *p_memory, size_t budget);
+
+// One step of the incremental defragmentation, moves allocated blocks left over the first free block(s) 
+// from memory->defrag_position, until memory->defrag_budget bytes were moved
+//
+// Input : A pointer to the memory
+//
+// Output : The free block is pushed right past the moved blocks (and merged with the free blocks it reaches), 
+// the pointers of the moved blocks are moved with them, does nothing if the budget is 0
+void defrag_step(Memory *p_memory);
+
+// Swaps a free block with the allocated block after it, the bytes of the allocated block move to the start of the free block
+//
+// Input : A pointer to the memory and the id of a free block that has an allocated block after it
+//
+// Output : The allocated block (and the pointers into it) starts where the free block started, and the free block starts right after it
+void swap_with_next_block(Memory *p_memory, BlockId free_block);
+
+#endif // DEFRAG_H
@@ -0,0 +1,88 @@
+#ifndef FORKS_H
+#define FORKS_H
+
+#include "general_management.h"
+
+// Arguments parser for the fork_memory function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function fork_memory if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status fork_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parser for the switch_memory function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function switch_memory if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status switch_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parser for the drop_memory function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function drop_memory if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status drop_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Makes a copy-on-write copy of the whole memory (bytes, block table, pointers and regions) that can be switched to later, by forking the process (Linux only).
+// The kernel only copies a page when one of the forks writes to it, so a fork costs as much memory as what changes after it
+//
+// Input : A pointer to the memory and the name of the new fork
+//
+// Output : Returns 1 in this process, which keeps running the commands, and the new process waits until it is switched to
+// (then it returns 1 as well, with memory->fork_slot set to its own slot). Returns 0 (after printing an error) if it couldn't fork
+uint8_t fork_memory(Memory *p_memory, const char *name);
+
+// Lets another fork run the next commands, and waits until a fork switches back to this one
+//
+// Input : A pointer to the memory and the slot of the fork to switch to
+//
+// Output : Returns when this fork is switched to again (the memory is as it was when it switched away)
+void switch_memory(Memory *p_memory, uint32_t slot);
+
+// Deletes a fork that is not the one running, so the pages only it had are given back to the system
+//
+// Input : A pointer to the memory and the slot of the fork
+//
+// Output : Kills the process of the fork and frees its slot
+void drop_memory(Memory *p_memory, uint32_t slot);
+
+// Kills the processes of every other fork, called before the program exits
+//
+// Input : A pointer to the memory
+//
+// Output : Every fork but this one is dropped, and the shared registry is unmapped
+void drop_all_forks(Memory *p_memory);
+
+// Creates the registry of the forks the first time the fork command is used
+//
+// Input : A pointer to the memory
+//
+// Output : Maps the registry (shared between processes), creates a pipe for every slot, shares stdin (see share_stdin) and puts the current memory in slot 0 as "main",
+// returns a boolean (0 or 1) if it succeded or not
+uint8_t init_fork_registry(Memory *p_memory);
+
+// Makes stdin unbuffered before the first fork, because the forks read the commands from the same stdin and none of them may read ahead of the commands it runs
+//
+// Input : None
+//
+// Output : A file goes back to the first command that wasn't run and a terminal gives one line at a time, so both only become unbuffered.
+// The commands that were read ahead from a pipe can't be put back, so a process copies them and the rest of the pipe to a new pipe that becomes stdin.
+// Returns a boolean (0 or 1) if it succeded or not
+uint8_t share_stdin(void);
+
+// Finds the slot of a fork by its name
+//
+// Input : A pointer to the memory and the name of the fork
+//
+// Output : Returns the index of the slot, or FORK_MAX_AMOUNT if there is no fork with that name (or no forks at all)
+uint32_t find_fork(Memory *p_memory, const char *name);
+
+// Waits until another fork switches to the fork of this process
+//
+// Input : A pointer to the memory
+//
+// Output : Returns when FORK_TURN is written to the pipe of memory->fork_slot, exits as soon as the process that runs the commands is gone
+void wait_for_turn(Memory *p_memory);
+
+#endif // FORKS_H
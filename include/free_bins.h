@@ -0,0 +1,40 @@
+#ifndef FREE_BINS_H
+#define FREE_BINS_H
+
+#include "general_management.h"
+
+// The most blocks free_bins_find looks at in one bin, so a bin with a lot of free blocks doesn't make malloc slow
+#define FREE_BINS_MAX_CANDIDATES 8
+
+// Gets the size class bin that a free block of <size> bytes belongs to
+//
+// Input : A size in bytes (must be more than 0)
+//
+// Output : Returns floor(log2(size)), so bin k holds the sizes 2^k to 2^(k+1) - 1
+unsigned int size_class(size_t size);
+
+// Adds a free block to the head of the bin for its size class and turns on the bin's bit in the bitmap
+//
+// Input : A pointer to the memory and the id of a free block
+//
+// Output : The block is linked into memory->arr_free_bins (or the TLSF lists), does nothing if the allocator doesn't keep bins.
+// memory->defrag_position moves back to the block if it is before it, so the defragmentation looks at the new gap
+void free_bins_insert(Memory *p_memory, BlockId block);
+
+// Removes a free block from the bin for its size class, and turns off the bin's bit if the bin became empty
+// Must be called before the size of the block changes, otherwise the wrong bin is searched
+//
+// Input : A pointer to the memory and the id of a free block that is in one of the bins
+//
+// Output : The block is unlinked from memory->arr_free_bins (or the TLSF lists), does nothing if the allocator doesn't keep bins
+void free_bins_remove(Memory *p_memory, BlockId block);
+
+// Finds a free block that fits <size> bytes well, by only looking at bins that can hold a block that big,
+// and at most FREE_BINS_MAX_CANDIDATES blocks of a bin
+//
+// Input : A pointer to the memory and the size of the allocation
+//
+// Output : Returns the id of the best fitting free block of the ones it looked at, or NO_BLOCK if no free block is big enough
+BlockId free_bins_find(Memory *p_memory, size_t size);
+
+#endif // FREE_BINS_H
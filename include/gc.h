@@ -0,0 +1,46 @@
+#ifndef GC_H
+#define GC_H
+
+#include "general_management.h"
+
+// How many bytes the conservative scan reads as one number (in both byte orders), enough for any index of a memory over 4 GB.
+// A block smaller than this is read as one number
+#define GC_SCAN_WIDTH 8
+
+// Arguments parser for the collect_garbage function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function collect_garbage if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status gc_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parser for the gc_auto command, which sets how my_malloc() collects garbage when it can't find a free block
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Sets memory->gc_auto if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status gc_auto_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Frees every allocated block that can't be reached (mark and sweep). The roots are the pointers in memory->p_pointers and the blocks of the regions,
+// and with GC_CONSERVATIVE, the bytes of every reachable block are scanned for numbers that are the start of a block as well
+//
+// Input : A pointer to the memory, how to find references (GC_POINTERS or GC_CONSERVATIVE), and where to put how many bytes were freed
+//
+// Output : Returns how many blocks were freed, the free blocks are merged in the same sweep
+size_t collect_garbage(Memory *p_memory, Gc_Mode mode, size_t *p_freed_bytes);
+
+// Marks a block as reachable in the side bitmap of the collector
+//
+// Input : The mark bitmap (one bit per block id) and the id of the block
+//
+// Output : Returns 1 if the block was not marked before (so it has to be scanned), or 0 if it was
+uint8_t gc_mark(uint64_t *p_marks, BlockId block);
+
+// Reads the bytes of a reachable block as numbers in both byte orders, and marks the blocks that start at one of them (conservative, any number can be an index)
+//
+// Input : A pointer to the memory, the mark bitmap, the id of the block, and the stack of blocks to scan and its size
+//
+// Output : Every block that the bytes might point at is marked and pushed to the stack
+void gc_scan_block(Memory *p_memory, uint64_t *p_marks, BlockId block, BlockId *p_stack, size_t *p_stack_size);
+
+#endif // GC_H
@@ -8,41 +8,103 @@
 #include <math.h>
 #include <string.h>  // For memmove
 #include <stdint.h> // unsigned int with 8 bits array of memory in the bytes
+#include <inttypes.h> // For PRId64, to print Pointer.start_index
 #include "memory_structs.h"
 #include "utils.h"
+#include "pages.h"
+#include "shadow.h"
+#include "watch.h"
 #include "visualize.h"
 #include "my_malloc.h"
 #include "my_free.h"
+#include "my_realloc.h"
+#include "batch.h"
+#include "gc.h"
+#include "grow.h"
+#include "free_bins.h"
+#include "buddy.h"
+#include "tlsf.h"
+#include "allocators.h"
+#include "regions.h"
+#include "arena.h"
+#include "pool.h"
+#include "nursery.h"
+#include "compact.h"
+#include "defrag.h"
+#include "snapshot.h"
+#include "forks.h"
+#include "journal.h"
 #include "interact_with_memory.h"
+#include "bulk_memory.h"
+#include "vector_ops.h"
 #include "cli.h"
 #include "pointer_management.h"
 
-// Moves all items in the block array in the memory starting from an index one index left
+// How many bytes of the bytes array share one slot of the block map (see find_block), a power of two
+#define BLOCK_MAP_PAGE_SIZE 16
+
+// Calculates how many bytes the arrays of a block table with <capacity> slots take together
+//
+// Input : The amount of slots in the block table
+//
+// Output : Returns the size in bytes of the storage that init_block_table needs for <capacity> slots
+size_t block_table_storage_size(size_t capacity);
+
+// Calculates how many slots the block table of a memory needs
+//
+// Input : The size of the memory in bytes
+//
+// Output : Returns one slot for every byte (there can't be more blocks than bytes), but less than NO_BLOCK so every slot has an id
+size_t block_table_capacity(size_t memory_size);
+
+// Splits one buffer into the arrays of a block table (so the table can be on the stack or one malloc)
+//
+// Input : A pointer to the block table, a buffer of block_table_storage_size(capacity) bytes aligned for size_t, and the amount of slots
+//
+// Output : Points every array of the table into the buffer, the widest arrays first so they stay aligned
+void init_block_table(BlockTable *p_table, void *p_storage, size_t capacity);
+
+// Takes an unused slot from the block table for a new block
 //
-// Input : A pointer to the memory, the starting index
+// Input : A pointer to the memory
 //
-// Output : Moves all items in the memory blocks array such that if index = 0, memory->blocks[0] = memory->blocks[1], memory->blocks[1] = memory->blocks[2]...
-// Ends up overwriting the index <index> in blocks array
-// Returns a boolean (0 or 1) based on failure/success
-uint8_t shift_left(Memory *p_memory, unsigned int index);
+// Output : Returns the id of an unused slot, reusing slots of blocks that were merged away first,
+// or NO_BLOCK if every slot of the block table is in use
+BlockId take_block_slot(Memory *p_memory);
 
+// Gives back the slot of a block that is no longer in the linked list, so a later split can reuse it
+//
+// Input : A pointer to the memory and the id of the block whose slot is not needed anymore
+//
+// Output : Pushes the slot to the head of the free slots list (chained through p_next)
+void release_block_slot(Memory *p_memory, BlockId block);
+
+// Registers a block that starts at its start index in the block map, so find_block can locate it
+//
+// Input : A pointer to the memory and the id of the new block
+//
+// Output : If the block is the first block that starts in its page of the bytes array, the page points at it
+void block_map_insert(Memory *p_memory, BlockId block);
+
+// Unregisters a block from the block map before it is removed from the linked list
+//
+// Input : A pointer to the memory and the id of the block that is going away (still linked)
+//
+// Output : If the page pointed at the block, it now points at the next block in the same page (or is empty)
+void block_map_remove(Memory *p_memory, BlockId block);
 
-// Moves all items in the block array in the memory starting from an index one index right
+// Finds the allocated block in the block table that starts at an index in the bytes array (where a Pointer points)
 //
-// Input : A pointer to the memory, the starting index
+// Input : A pointer to the memory and the lookup index
 //
-// Output : Moves all items in the memory blocks array such that if index = 0, memory->blocks[1] = memory->blocks[0], memory->blocks[2] = memory->blocks[1]...
-// Ends up overwriting the last index of the blocks array
-// Returns a boolean (0 or 1) based on failure/success
-uint8_t shift_right(Memory *p_memory, unsigned int index);
+// Output : Returns the id of the block found, or NO_BLOCK if no allocated block starts at the index
+BlockId find_block(Memory *p_memory, size_t index);
 
-// Finds a block in the blocks array based on a corresponding index in the bytes array
+// Finds the block (free or allocated) whose bytes include an index in the bytes array
 //
-// Input : A pointer to the memory, the lookup index, and a block double pointer to store a pointer for the block 
-//(**block is a pointer to a *block pointer which lets you acess the block the function found)
+// Input : A pointer to the memory and the lookup index
 //
-// Output : assigns the pointer that the double pointer block holds, to a pointer to the block found, 
-// and returns the index of the block in the blocks array as well (or -1 if not found)
-int find_block(Memory *p_memory, unsigned int index, Block **pp_block);
+// Output : Returns the id of the block that the index is in, or NO_BLOCK if the index is outside of the bytes array
+BlockId find_block_containing(Memory *p_memory, size_t index);
 
 #endif // GENERAL_MANAGEMENT_H
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef GROW_H
+#define GROW_H
+
+#include "general_management.h"
+
+#define MAX_SIZE_STACK ((1 << 19) / BLOCK_METADATA_SIZE)  // 2^19 = 512 KB
+#define MAX_SIZE_HEAP ((1 << 29) / BLOCK_METADATA_SIZE) // 2^29 = 512 MB
+#define MAX_SIZE_MMAP ((size_t)1 << 36) // 64 GB, only the pages that are used take memory, so the metadata doesn't lower the limit
+
+// Gets the biggest size a memory can have with a backing, at startup and when it grows
+//
+// Input : Where the memory is allocated
+//
+// Output : Returns MAX_SIZE_STACK, MAX_SIZE_HEAP or MAX_SIZE_MMAP
+size_t backing_max_size(Memory_Backing backing);
+
+// Arguments parser for the grow_memory function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function grow_memory if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status grow_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parser for the grow_limit command, which sets up to what size my_malloc() grows the memory when it can't find a free block
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Sets memory->max_memory_size if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status grow_limit_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Called when my_malloc can't find a free block (and collecting garbage didn't help), grows the memory (if memory->max_memory_size allows it) and tries again
+//
+// Input : A pointer to the memory, a size of allocation, and a pointer to a pointer struct
+//
+// Output : Returns the result of my_malloc after the memory grew, or 0 if it can't grow
+uint8_t retry_after_grow(Memory *p_memory, size_t size, Pointer *p_ptr);
+
+// Makes the memory bigger, the new bytes are a free block at the end that merges with the free block before it.
+// Blocks and pointers keep their ids and indices, only the arrays they are in can move
+//
+// Input : A pointer to the memory and its new size (more than its size)
+//
+// Output : Resizes the bytes array, its shadow, the block map, the pointer index and the block table and adds the new bytes as free memory,
+// returns a boolean (0 or 1) if it succeded or not (then the memory didn't change)
+uint8_t grow_memory(Memory *p_memory, size_t new_size);
+
+// Resizes one array of the memory the way its backing allocates (realloc or mremap)
+//
+// Input : A pointer to the memory, the array, its size in bytes and its new size in bytes
+//
+// Output : Returns a pointer to the resized array (the new bytes are zeroed), or NULL if it failed (then the array didn't change)
+void* resize_backing(Memory *p_memory, void *p_array, size_t old_size, size_t new_size);
+
+// Moves the block table to a bigger storage, every array of the table starts at a different place when the capacity changes
+//
+// Input : A pointer to the memory and the new amount of slots
+//
+// Output : Copies the used slots of every array to a new storage and frees the old one,
+// returns a boolean (0 or 1) if it succeded or not (then the table didn't change)
+uint8_t grow_block_table(Memory *p_memory, size_t new_capacity);
+
+// Adds free bytes after the last block, the way the allocator frees them
+//
+// Input : A pointer to the memory (whose memory_size already includes the bytes), where the bytes start and how many there are
+//
+// Output : Links a free block (with BUDDY, aligned powers of two) for the bytes after the last block and merges it with the free blocks before it
+void append_free_memory(Memory *p_memory, size_t start, size_t size);
+
+#endif // GROW_H
@@ -3,12 +3,15 @@
 
 #include "general_management.h"
 
+#define AMOUNT_OF_SCALAR_TYPES 6
+extern const Scalar_Type arr_scalar_types[AMOUNT_OF_SCALAR_TYPES];
+
 // Arguments parser for the set_val function
 //
 // Input : A pointer to the memory and the amount of arguments and the arguments
 //
-// Output : Calls the function set_val if all the arguments are valid
-void set_val_command(Memory *p_memory, int args_c, char *args[10]);
+// Output : Calls the function set_val if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status set_val_command(Memory *p_memory, int args_c, char *args[10]);
 
 // Given a pointer to a certain block, set the value of that block to the value passed along with the pointer
 //
@@ -17,4 +20,62 @@ void set_val_command(Memory *p_memory, int args_c, char *args[10]);
 // Output : Sets the rightmost slot in the block to the value <value>
 uint8_t set_val(Memory *p_memory, uint8_t value, Pointer ptr);
 
+// Arguments parser for the store_scalar function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function store_scalar if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status store_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parser for the load_scalar function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function load_scalar if all the arguments are valid, prints the value and returns how the command ended (see Command_Status)
+Command_Status load_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Writes a number of <width> bytes into what a pointer points at, without touching the other bytes of the block
+//
+// Input : A pointer to the memory, the pointer, the offset from the start of what it points at, the bits of the number (in the lowest <width> bytes),
+// the width and the byte order to write (1 for big endian)
+//
+// Output : Returns a boolean (0 or 1) if it succeded or not (the pointer is not valid or the number doesn't fit after the offset)
+uint8_t store_scalar(Memory *p_memory, Pointer ptr, size_t offset, uint64_t bits, uint8_t width, uint8_t big_endian);
+
+// Reads a number of <width> bytes from what a pointer points at
+//
+// Input : A pointer to the memory, the pointer, the offset from the start of what it points at, the width, the byte order to read (1 for big endian)
+// and where to put the bits of the number
+//
+// Output : Puts the bits in the lowest <width> bytes of *p_bits, returns a boolean (0 or 1) if it succeded or not
+uint8_t load_scalar(Memory *p_memory, Pointer ptr, size_t offset, uint8_t width, uint8_t big_endian, uint64_t *p_bits);
+
+// Finds where a typed access starts in the bytes array, after checking that it is inside what the pointer points at
+//
+// Input : A pointer to the memory, the pointer, the offset and the width of the access
+//
+// Output : Returns the index of the first byte, or SIZE_MAX (after printing an error) if the access doesn't fit
+size_t scalar_index(Memory *p_memory, Pointer ptr, size_t offset, uint8_t width);
+
+// Finds a type by its name and byte order, like u32le
+//
+// Input : The name, and where to put the type and the byte order
+//
+// Output : Returns a boolean (0 or 1) if the name is a type or not
+uint8_t parse_scalar_type(const char *name, const Scalar_Type **pp_type, uint8_t *p_big_endian);
+
+// Reverses the order of the lowest <width> bytes of a number, to turn the byte order of this machine into the other one
+//
+// Input : The bits and the width
+//
+// Output : Returns the bits with the lowest <width> bytes reversed (the other bytes are 0)
+uint64_t swap_scalar_bytes(uint64_t bits, uint8_t width);
+
+// Checks the byte order of the machine the program runs on
+//
+// Input : None
+//
+// Output : Returns 1 if the highest byte of a number is kept first, 0 if the lowest is
+uint8_t host_is_big_endian(void);
+
 #endif // INTERACT_WITH_MEMORY_H
\ No newline at end of file
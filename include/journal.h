@@ -0,0 +1,150 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "general_management.h"
+
+// The first bytes of every journal file, and the version of the format after them
+#define JOURNAL_MAGIC "BYTHJRNL"
+#define JOURNAL_VERSION 1
+
+// The records are synced to the disk at most this often (group commit), a crash of the system loses at most the records of the last interval.
+// A crash of the program loses nothing, every record is flushed to the system when it is written
+#define JOURNAL_SYNC_INTERVAL_MS 100
+
+// Journal_Record.command of a record that only has defrag steps (written when the journal stops), not an index of arr_journal_commands
+#define JOURNAL_NO_COMMAND 0xFF
+
+// Journal_Record.flags bit, on if the command printed a success when it was recorded (a replay that ends differently doesn't match)
+#define JOURNAL_SUCCEEDED 0x01
+
+// The commands that change the memory, a record saves the index of its command in this array (new commands go at the end, so old journals keep their indices)
+#define AMOUNT_OF_JOURNAL_COMMANDS 30
+extern const char *arr_journal_commands[AMOUNT_OF_JOURNAL_COMMANDS];
+
+// The start of a journal file, followed by <snapshot_path_length> chars of the path of the snapshot the records are replayed on (without a '\0').
+// The settings of the memory are not in a snapshot, so they are saved here as they were when the snapshot was taken
+typedef struct {
+    char arr_magic[8]; // JOURNAL_MAGIC, without the '\0'
+    uint32_t version; // JOURNAL_VERSION
+    uint32_t snapshot_path_length;
+    uint32_t allocator; // The Allocator_Type of the memory, it has to be the allocator of the memory that recovers
+    uint32_t gc_auto;
+    uint64_t defrag_budget;
+    uint64_t defrag_position;
+    uint64_t max_memory_size;
+    uint64_t next_fit_start; // The start index of the block memory->next_fit_rover was at, UINT64_MAX for NO_BLOCK
+} Journal_Header;
+
+// A command in a journal file, followed by <payload_length> bytes: for every argument a uint16_t length and its chars (without a '\0')
+typedef struct {
+    uint32_t checksum; // journal_checksum of the rest of the record and the payload, a record that was cut off by a crash doesn't match it
+    uint32_t defrag_steps; // Steps of the incremental defragmentation that ran since the record before, they are replayed before the command
+    uint16_t payload_length;
+    uint8_t command; // Index in arr_journal_commands, or JOURNAL_NO_COMMAND
+    uint8_t flags; // JOURNAL_SUCCEEDED
+} Journal_Record;
+
+// Arguments parser for the journal_start and journal_stop functions
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function journal_start with the path, or journal_stop for off, if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status journal_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parser for the journal_replay function
+//
+// Input : A pointer to the memory, a pointer to the commands hashmap and the amount of arguments and the arguments
+//
+// Output : Calls the function journal_replay if all the arguments are valid
+void recover_command(Memory *p_memory, HashMap *p_cmds, int args_c, char *args[10]);
+
+// Starts recording every command that changes the memory, on top of a snapshot of the memory as it is now (saved to <path>.snap)
+//
+// Input : A pointer to the memory and the path of the journal
+//
+// Output : Saves the snapshot and writes the header of the journal, returns a boolean (0 or 1) if it succeded or not
+uint8_t journal_start(Memory *p_memory, const char *path);
+
+// Stops the journal, after syncing what is left of it to the disk
+//
+// Input : A pointer to the memory
+//
+// Output : Writes the last defrag steps, syncs and closes the journal file
+void journal_stop(Memory *p_memory);
+
+// Closes the journal of this process without writing to it, so a fork doesn't write to the journal of the memory it was forked from
+//
+// Input : A pointer to the memory
+//
+// Output : memory->journal.p_file is NULL
+void journal_detach(Memory *p_memory);
+
+// Starts the journal over on top of a new snapshot, the records before it are not needed to recover anymore
+//
+// Input : A pointer to the memory and the path of the snapshot (that was just saved or loaded)
+//
+// Output : Writes a journal with only a header to <path>.tmp, syncs it and renames it over the journal (so a crash leaves the old or the new one whole),
+// returns a boolean (0 or 1) if it succeded or not (then the journal is stopped)
+uint8_t journal_checkpoint(Memory *p_memory, const char *snapshot_path);
+
+// Called by execute_command after every command that printed a success or an error, records it if it changes the memory
+//
+// Input : A pointer to the memory, the amount of arguments and the arguments (with the name of the command first)
+// and if the command printed a success
+//
+// Output : Appends a record of the command (or a checkpoint after snapshot_save and snapshot_load), does nothing if the journal is off
+void journal_after_command(Memory *p_memory, int args_c, char *args[10], uint8_t succeeded);
+
+// Appends one record to the journal and syncs the journal if JOURNAL_SYNC_INTERVAL_MS passed since the last sync
+//
+// Input : A pointer to the memory, the index of the command (or JOURNAL_NO_COMMAND), the flags, and the amount of arguments and the arguments
+// (without the name of the command)
+//
+// Output : Writes the record with memory->journal.defrag_steps and sets them to 0, returns a boolean (0 or 1) if it succeded or not
+uint8_t journal_write_record(Memory *p_memory, uint8_t command, uint8_t flags, int args_c, char **args);
+
+// Syncs the journal file to the disk
+//
+// Input : A pointer to the memory
+//
+// Output : Flushes and syncs the journal file, and sets memory->journal.last_sync_ms
+void journal_sync(Memory *p_memory);
+
+// Writes everything that was written to a file to the disk, so it is not lost if the system crashes
+//
+// Input : A pointer to the file
+//
+// Output : Flushes the buffer of the file and waits until the system wrote the file to the disk
+void sync_file(FILE *p_file);
+
+// Replays a journal on top of the snapshot it starts from
+//
+// Input : A pointer to the memory, a pointer to the commands hashmap, the path of the journal and where to put how many commands were replayed
+// and how many of them didn't end the way they ended when they were recorded
+//
+// Output : Loads the snapshot, sets the settings from the header and runs the commands, stops at the first record that is cut off or doesn't match its checksum,
+// returns a boolean (0 or 1) if it succeded or not
+uint8_t journal_replay(Memory *p_memory, HashMap *p_cmds, const char *path, size_t *p_replayed, size_t *p_mismatched);
+
+// Finds the index of a command in arr_journal_commands
+//
+// Input : The name of the command
+//
+// Output : Returns the index, or JOURNAL_NO_COMMAND if the command doesn't change the memory
+uint8_t find_journal_command(const char *name);
+
+// Checksum of the bytes of a record (FNV-1a), continues from the checksum of the bytes before them
+//
+// Input : A pointer to the bytes, how many there are and the checksum so far (2166136261 for the first bytes)
+//
+// Output : Returns the checksum
+uint32_t journal_checksum(const uint8_t *p_bytes, size_t size, uint32_t checksum);
+
+// Gets the time in milliseconds, to know when to sync the journal
+//
+// Input : None
+//
+// Output : Returns the milliseconds since the epoch
+uint64_t journal_now_ms(void);
+
+#endif // JOURNAL_H
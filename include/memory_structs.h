@@ -5,38 +5,191 @@
 #include "general_management.h"
 #include "utils.h"
 
-// A pointer struct, save the address of the block (index in byte array) it points at in memory
+// How many size classes the segregated free bins have, one bin per power of two (bin k holds sizes 2^k to 2^(k+1) - 1, with BUDDY only 2^k)
+#define AMOUNT_OF_SIZE_CLASSES 64
+
+// How many linear parts the TLSF allocator splits every power of two range into (as a power of two), 2^4 = 16 lists per range
+#define TLSF_SL_LOG2 4
+#define TLSF_SL_COUNT (1 << TLSF_SL_LOG2)
+
+// Which algorithm my_malloc() uses to find a free block for an allocation (see arr_allocators in allocators.h)
+typedef enum {
+    BEST_FIT = 0, // Scan every block in the blocks array and take the closest size
+    SEGREGATED_FIT = 1, // Keep free blocks in power of two size class bins and only look at the bins that can fit
+    BUDDY = 2, // Only power of two blocks aligned to their size, split in halves on malloc and merged with their buddy on free
+    TLSF = 3, // Two level segregated fit, free lists for parts of every power of two range, found with two bitmap lookups
+    FIRST_FIT = 4, // Scan the blocks and take the first one that fits
+    NEXT_FIT = 5, // Like first fit, but start from the block the last search found
+    WORST_FIT = 6, // Scan every block and take the biggest one
+    AMOUNT_OF_ALLOCATORS // Not an allocator, the amount of allocators
+} Allocator_Type;
+
+// Which loops the bulk memory commands (mem_set, mem_copy, mem_move and mem_cmp) and the vector commands run, the widest the CPU supports
+// (see arr_bulk_kernels in bulk_memory.h and arr_vector_kernels in vector_ops.h)
+typedef enum {
+    BULK_SCALAR = 0, // The C library functions, for CPUs without SSE2 (and not x86 at all)
+    BULK_SSE2 = 1, // 16 bytes at a time
+    BULK_AVX2 = 2, // 32 bytes at a time
+    AMOUNT_OF_BULK_KERNELS // Not a kernel, the amount of kernels
+} Bulk_Kernel_Type;
+
+// Where the bytes and the metadata of the memory are allocated, chosen at startup
+typedef enum {
+    STACK_BACKED = 0, // Arrays on the stack of main, small but no allocation at all
+    HEAP_BACKED = 1, // c malloc
+    MMAP_BACKED = 2, // Linux only, address space is reserved with mmap and every page is only committed when it is first used
+    MMAP_HUGE_PAGES_BACKED = 3 // Like MMAP_BACKED, and asks for transparent huge pages (less TLB misses on big memories)
+} Memory_Backing;
+
+// Index of a block's slot in the block table, 32 bits so the links between blocks are half the size of a pointer
+typedef uint32_t BlockId;
+
+// What kind of allocations a region hands out from its block
+typedef enum {
+    ARENA = 0, // Bump pointer allocations, all released at once by arena_reset
+    POOL = 1, // Objects of one fixed size, each released by pool_free
+    NURSERY = 2 // Bump pointer allocations of the malloc command, the survivors are promoted to the main memory by minor_collect
+} Region_Type;
+
+// What the garbage collector treats as a reference to a block
+typedef enum {
+    GC_OFF = 0, // Don't collect (only for Memory.gc_auto)
+    GC_POINTERS = 1, // Only the pointers in Memory.p_pointers (and the blocks of the regions)
+    GC_CONSERVATIVE = 2 // The pointers, and any bytes in a reachable block that look like the start of a block
+} Gc_Mode;
+
+// How a memory command ended, the journal records it and a replay compares it with what was recorded (see journal_after_command)
+typedef enum {
+    COMMAND_FAILED = 0, // It printed an error
+    COMMAND_SUCCEEDED = 1,
+    COMMAND_CANCELED = 2 // Nothing was done, like a declined confirmation, so it is not journaled
+} Command_Status;
+
+// A region is one allocated block of the memory that hands out its own allocations, 
+// without a block in the block table for every allocation
 typedef struct {
-    int start_index;
+    Region_Type type;
+    BlockId block; // The block of the memory that the region owns
+    uint32_t generation; // Incremented when all the allocations of the region are released, pointers from older generations are invalid
+    size_t used; // ARENA and NURSERY: how many bytes from the start of the block were handed out, POOL: how many objects are allocated
+    uint32_t object_size; // POOL: the size of every object in bytes, NURSERY: the size of the biggest allocation it hands out
+    uint32_t count; // POOL: how many objects fit in the block
+    uint32_t free_head; // POOL: index of the first free object, the rest of the free list is stored inside the free objects
+} Region;
+
+// A pointer struct, save the address of the block (index in byte array) it points at in memory
+typedef struct Pointer {
+    int64_t start_index; // -1 if the pointer was not allocated yet, 64 bits so memories bigger than 2 GB can be addressed
+    size_t size; // How many bytes were requested for the pointer
+    Region *p_region; // The region the pointer was allocated from, NULL for the main memory
+    uint32_t generation; // The generation of the region when the pointer was allocated
+    uint8_t is_indexed; // Boolean, if the pointer is in a list of Memory.pp_pointer_index (only the pointers of Memory.p_pointers are, never copies)
+    size_t indexed_page; // The page of the list it is in, its start_index could have changed since (see pointer_index_update)
+    struct Pointer *p_prev_indexed; // The pointers before and after it in the list of its page
+    struct Pointer *p_next_indexed;
 } Pointer;
 
-// Block struct, made to make sure that you do not accidentally double allocated,
-// and in general used to track memory on the management level
-struct Block {
-    size_t size;
-    size_t start_index;
-    struct Block* p_next;
-    struct Block* p_prev;
-    uint8_t free;
-    uint8_t uninitialized;
-};
+// A type that store, load and the vector commands read and write, its name is followed by le (the lowest byte first) or be (the highest byte first, the way set_val writes)
+typedef struct {
+    const char *p_name; // "u16", without the byte order
+    uint8_t width; // Bytes
+    uint8_t is_float; // f32 and f64 are kept as their IEEE 754 bits
+} Scalar_Type;
+
+// The biggest path of a journal file, with its '\0'
+#define JOURNAL_PATH_SIZE 256
+
+// The command journal of a memory (see journal.h), p_file is NULL when there is no journal
+typedef struct {
+    FILE *p_file; // Opened for appending, every record is flushed to the system right away and synced in groups
+    char arr_path[JOURNAL_PATH_SIZE]; // A checkpoint writes a new file next to it and renames it over this path
+    uint64_t last_sync_ms; // When the records were last synced to the disk (see journal_now_ms)
+    uint32_t defrag_steps; // Steps of the incremental defragmentation since the last record, replayed before the next one
+} Journal;
+
+// How many forks of the memory (with the first one) can exist at once, and how long their names can be (with the '\0')
+#define FORK_MAX_AMOUNT 16
+#define FORK_NAME_SIZE 32
+
+// The bytes written to the pipe of a waiting fork, its turn to run the commands, or another fork runs them now (so it watches that process instead)
+#define FORK_TURN 1
+#define FORK_NEW_ACTIVE 2
+
+// One fork of the memory, a process that has its own copy-on-write copy of everything (see fork_memory)
+typedef struct {
+    char arr_name[FORK_NAME_SIZE]; // Empty if the slot is not used
+    int32_t pid;
+    int arr_turn_pipe[2]; // Writing a byte to [1] wakes the process of the slot, which waits on [0] while another fork is used
+} Fork_Slot;
 
-// Block struct, made to make sure that you do not accidentally double allocated,
-// and in general used to track memory on the management level
-typedef struct Block Block; 
+// The forks that exist, in memory that all of their processes share
+typedef struct {
+    Fork_Slot arr_slots[FORK_MAX_AMOUNT]; // Slot 0 is the memory that the program started with
+    int32_t active_pid; // The process that reads the commands, the waiting ones exit if it is gone
+} Fork_Registry;
+
+// Marks a link that doesn't point at any block (like NULL for pointers)
+#define NO_BLOCK ((BlockId)0xFFFFFFFF)
+
+// Bits of BlockTable.p_states, packed into one byte per block
+#define BLOCK_FREE 0x01 // The block is free
+#define BLOCK_REGION 0x04 // The block is owned by a region (see Region), free only frees it through the region
+
+// How many bytes of metadata every slot of the block table costs (one slot is needed for every byte of memory in the worst case)
+#define BLOCK_METADATA_SIZE (2 * sizeof(size_t) + sizeof(uint8_t) + 4 * sizeof(BlockId))
+
+// Block table, made to make sure that you do not accidentally double allocated,
+// and in general used to track memory on the management level.
+// Every block is a slot index (BlockId), and each of its fields is in a separate array (struct of arrays), 
+// so searching for a free block only reads the sizes and states and not the links.
+typedef struct {
+    // Hot fields, read by every search for a free block
+    size_t *p_sizes;
+    uint8_t *p_states; // BLOCK_FREE and BLOCK_REGION bits (which bytes hold garbage is in Memory.p_shadow)
 
-// No clue why I need to typedef like this, gcc gives me warnings otherwise
+    // Cold fields, only read when blocks are split, merged or looked up
+    size_t *p_start_indices;
+    BlockId *p_next; // Next block in memory (also chains the free slots)
+    BlockId *p_prev; // Previous block in memory
+    BlockId *p_next_free; // Next block in the same size class bin (only used by allocators that keep bins)
+    BlockId *p_prev_free; // Previous block in the same size class bin (only used by allocators that keep bins)
+} BlockTable;
 
 // Memory struct, used to store the raw memory, the blocks, the length of both of these arrays
 // a pointer hashmap so that users can gives their own names to pointers and a flag if it was generate via malloc()
 // And then needs to be freed on exiting the program or if it was made in main's stack, and then there is no need.
 typedef struct {
     uint8_t *p_bytes;  // 1 byte per slot in the array
-    Block *p_blocks;  // Metadata for all the blocks in the memory
+    BlockTable blocks;  // Pool of slots for the metadata of the blocks, in no particular order (follow the linked list for the order in memory)
+    BlockId first_block; // Head of the linked list, the block that starts at index 0 in the bytes array
+    BlockId free_slots; // Slots of blocks that were merged away, chained through p_next, reused before new slots
+    size_t amount_of_used_slots; // Slots after this index were never used
+    size_t block_capacity; // How many slots the block table has, one for every byte of memory but less than NO_BLOCK
+    uint64_t *p_shadow; // One bit for every byte of p_bytes, on if the byte was written since its block was allocated (see shadow.h)
+    BlockId *p_block_map; // For every BLOCK_MAP_PAGE_SIZE bytes, the first block that starts in them plus 1 (0 if none, so a zeroed map is empty)
+    Pointer **pp_pointer_index; // For every POINTER_INDEX_PAGE_SIZE bytes, a list of the pointers of p_pointers that start in them (a zeroed index is empty)
     size_t amount_of_blocks;
     size_t memory_size;
     HashMap *p_pointers;
-    uint8_t on_heap;
+    HashMap *p_regions; // Region structs by their names
+    HashMap *p_watches; // Watchpoint structs by the names of their pointers (see watch.h)
+    uint64_t *p_watch_pages; // Bit k is on if a watchpoint has a byte in page k (WATCH_PAGE_SIZE bytes), NULL when there are no watchpoints
+    Region *p_nursery; // The region that the malloc command hands small allocations out of (also in p_regions), NULL if there is none
+    Fork_Registry *p_forks; // Shared by the processes of all the forks, NULL until the first fork
+    uint32_t fork_slot; // The slot of this process in p_forks
+    Journal journal; // The commands that changed the memory since the last snapshot, journal.p_file is NULL when it is off
+    Memory_Backing backing; // Where p_bytes, p_shadow, the block table and the block map were allocated (see exit_program_bytethon)
+    Allocator_Type allocator; // Which search algorithm my_malloc() uses
+    Bulk_Kernel_Type bulk_kernels; // Which loops the bulk memory commands use, chosen at startup by select_bulk_kernels()
+    BlockId next_fit_rover; // Where the next search of the NEXT_FIT allocator starts (NO_BLOCK for the first block)
+    size_t defrag_budget; // How many bytes the incremental defragmentation may move after every command, 0 if it is off
+    size_t defrag_position; // Index in the bytes array that the next defragmentation step continues from, memory_size when there are no gaps left
+    size_t max_memory_size; // How big my_malloc() may grow the memory when it can't find a free block, 0 to not grow
+    Gc_Mode gc_auto; // How my_malloc() collects garbage before it gives up on an allocation, GC_OFF to not collect
+    BlockId arr_free_bins[AMOUNT_OF_SIZE_CLASSES]; // Heads of the free block lists, one per size class
+    uint64_t free_bins_bitmap; // Bit k is on if arr_free_bins[k] is not empty (with TLSF, if arr_tlsf_sl_bitmaps[k] is not 0)
+    BlockId arr_tlsf_lists[AMOUNT_OF_SIZE_CLASSES][TLSF_SL_COUNT]; // Heads of the TLSF free lists, by first level and second level
+    uint32_t arr_tlsf_sl_bitmaps[AMOUNT_OF_SIZE_CLASSES]; // Bit j of item k is on if arr_tlsf_lists[k][j] is not empty
 } Memory;
 
 
@@ -7,8 +7,8 @@
 //
 // Input : A pointer to the memory and the amount of arguments and the arguments
 //
-// Output : Calls the function my_free if all the arguments are valid
-void my_free_command(Memory *p_memory, int args_c, char *args[10]);
+// Output : Calls the function my_free if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status my_free_command(Memory *p_memory, int args_c, char *args[10]);
 
 // Free a block that a pointer <**ptr> is pointing at.
 //
@@ -19,11 +19,11 @@ void my_free_command(Memory *p_memory, int args_c, char *args[10]);
 // Returns a boolean (0 or 1) for if it succeeded or not
 uint8_t my_free(Memory *p_memory,Pointer **pp_ptr);
 
-// Merges block at index <index> with block at index <index>+1, an attempt to reduce fragmentation in a simple manner
+// Merges the block <block> with the block after it in the linked list, an attempt to reduce fragmentation in a simple manner
 //
-// Input : A pointer to the memory and an index to where to merge
+// Input : A pointer to the memory and the id of the block to merge into
 //
-// Output : Block at index <index> eats block at index <index> + 1
-void merge_block_right(Memory *p_memory, unsigned int index); // Merges blocks (left side eats right side), for memory reducing fragmentation
+// Output : Block <block> eats the next block, whose slot goes back to the pool
+void merge_block_right(Memory *p_memory, BlockId block); // Merges blocks (left side eats right side), for memory reducing fragmentation
 
 #endif // MY_FREE_H
\ No newline at end of file
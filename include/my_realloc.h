@@ -0,0 +1,38 @@
+#ifndef MY_REALLOC_H
+#define MY_REALLOC_H
+
+#include "general_management.h"
+
+// Arguments parser for the my_realloc function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function my_realloc if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status my_realloc_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Changes the size of the block a pointer points at, in place when it can, and keeps the bytes that were in it
+//
+// Input : A pointer to the memory, the new size of the allocation, and a pointer to a pointer struct
+//
+// Output : Shrinks the block by splitting off a free tail, or grows it into the free block after it,
+// and only if neither is possible allocates a new block, copies the bytes to it and frees the old block.
+// Returns a boolean (0 or 1) if it succeded or not
+uint8_t my_realloc(Memory *p_memory, size_t new_size, Pointer *p_ptr);
+
+// Splits the end of an allocated block off into a free block, and merges it with the free block after it if there is one
+//
+// Input : A pointer to the memory, the id of an allocated block and its new size (less than its size)
+//
+// Output : The block has <new_size> bytes (and keeps its state), the bytes after them are free. 
+// Returns a boolean (0 or 1) if it succeded or not
+uint8_t shrink_block(Memory *p_memory, BlockId block, size_t new_size);
+
+// Grows an allocated block into the free block after it
+//
+// Input : A pointer to the memory, the id of an allocated block and its new size (more than its size)
+//
+// Output : Returns 1 if the block has <new_size> bytes now (what is left of the free block stays free), 
+// or 0 if the block after it is not free or not big enough
+uint8_t grow_block(Memory *p_memory, BlockId block, size_t new_size);
+
+#endif // MY_REALLOC_H
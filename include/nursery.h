@@ -0,0 +1,56 @@
+#ifndef NURSERY_H
+#define NURSERY_H
+
+#include "general_management.h"
+
+// The name the nursery is saved by in memory->p_regions (there is only one nursery)
+#define NURSERY_NAME "nursery"
+
+// Arguments parser for the nursery_create function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function nursery_create if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status nursery_create_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Creates the nursery, a region that the malloc command hands small allocations out of (bump pointer, like an arena),
+// so blocks that die young never split the main memory
+//
+// Input : A pointer to the memory, the size of the nursery in bytes and the biggest allocation it hands out
+//
+// Output : Carves one block of <size> bytes from the memory for the nursery and saves it in memory->p_nursery,
+// returns a boolean (0 or 1) if it succeded or not
+uint8_t nursery_create(Memory *p_memory, size_t size, size_t max_object_size);
+
+// Allocates <size> bytes from the nursery, and runs a minor collection first if the nursery is full
+//
+// Input : A pointer to the memory, the size of the allocation, and a pointer to a pointer struct
+//
+// Output : Points <*p_ptr> at the next <size> bytes of the nursery and returns 1, or returns 0 if there is no nursery,
+// the allocation is too big for it, or there is still no room after the collection (then the caller allocates from the main memory)
+uint8_t nursery_alloc(Memory *p_memory, size_t size, Pointer *p_ptr);
+
+// Arguments parser for the minor_collect function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function minor_collect if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status nursery_collect_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Empties the nursery, every pointer that still points into it survived and is promoted (copied) to a block of the main memory
+//
+// Input : A pointer to the memory, and where to put how many pointers and bytes were promoted
+//
+// Output : Returns 1 after resetting the nursery, or 0 (after printing an error) if a survivor didn't fit in the main memory,
+// then the survivors that were not promoted yet stay in the nursery and it is not reset
+uint8_t minor_collect(Memory *p_memory, size_t *p_promoted, size_t *p_promoted_bytes);
+
+// Moves the bytes of a pointer from the nursery to a new block of the main memory
+//
+// Input : A pointer to the memory and a pointer to a pointer struct that points into the nursery
+//
+// Output : Allocates a block of the size of the pointer with my_malloc, copies the bytes to it and points <*p_ptr> at it,
+// returns a boolean (0 or 1) if it succeded or not (then <*p_ptr> still points into the nursery)
+uint8_t promote_pointer(Memory *p_memory, Pointer *p_ptr);
+
+#endif // NURSERY_H
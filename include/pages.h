@@ -0,0 +1,42 @@
+#ifndef PAGES_H
+#define PAGES_H
+
+#include "general_management.h"
+
+// Reserves address space for an array with mmap, without committing memory for it (Linux only).
+// The kernel gives a page real memory (zeroed) only when it is first used, so reserving is O(1) in time no matter the size
+//
+// Input : The size of the array in bytes, and a boolean (0 or 1) for asking for transparent huge pages
+//
+// Output : Returns a pointer to the start of the reserved pages, or NULL if mmap failed (or on systems without mmap)
+void* reserve_pages(size_t size, uint8_t huge_pages);
+
+// Resizes pages that reserve_pages reserved, the kernel moves them to a new address (without copying the bytes) if they can't grow where they are
+//
+// Input : A pointer that reserve_pages (or resize_pages) returned, the size it was called with and the new size
+//
+// Output : Returns a pointer to the resized pages (the new pages are zeroed), or NULL if mremap failed (or on systems without mremap)
+void* resize_pages(void *p_pages, size_t old_size, size_t new_size);
+
+// Gives pages that reserve_pages reserved back to the system
+//
+// Input : A pointer that reserve_pages returned and the size it was called with
+//
+// Output : Unmaps the pages, does nothing for NULL
+void release_pages(void *p_pages, size_t size);
+
+// Maps a whole file into memory to read it, without copying it into a buffer (Linux only, other systems read it into a malloc buffer)
+//
+// Input : The path of the file and where to put its size
+//
+// Output : Returns a pointer to the (read only) bytes of the file and puts its size in *p_size, or NULL if it couldn't be opened (or is empty)
+const uint8_t* map_file(const char *path, size_t *p_size);
+
+// Gives back a file that map_file mapped
+//
+// Input : A pointer that map_file returned and the size it put in *p_size
+//
+// Output : Unmaps (or frees) the bytes, does nothing for NULL
+void unmap_file(const uint8_t *p_file, size_t size);
+
+#endif // PAGES_H
@@ -3,18 +3,53 @@
 
 #include "general_management.h"
 
+// How many bytes of the bytes array share one list of the pointer index (see pointer_index_move)
+#define POINTER_INDEX_PAGE_SIZE 256
+
 // Arguments parser for the new_pointer function
 //
 // Input : A pointer to the memory and the amount of arguments and the arguments
 //
-// Output : Calls the function new_pointer if all the arguments are valid
-void new_pointer_command(Memory *p_memory, int args_c, char *args[10]);
+// Output : Calls the function new_pointer if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status new_pointer_command(Memory *p_memory, int args_c, char *args[10]);
 
 // Creates a new pointer struct and adds it into the pointer struct hashmap in the memory struct
 //
-// Input : A pointer to a pointer struct hashmap (Usually inside a memory struct) and a name for the new pointer
+// Input : A pointer to the memory and a name for the new pointer
+//
+// Output : Initializes a new pointer struct into memory->p_pointers (replacing the pointer with the same name, if there is one)
+void new_pointer(Memory *p_memory, char *name);
+
+// Finds the bytes that a pointer points at, in the main memory or in a region
+//
+// Input : A pointer to the memory, a pointer struct, and pointers to where to put the start and the size of what it points at
+//
+// Output : Puts the start index and the size in *p_start and *p_size, and returns the id of the block that holds them 
+// (the region's block for pointers from a region), or returns NO_BLOCK (after printing an error) if the pointer is not valid
+BlockId resolve_pointer(Memory *p_memory, Pointer ptr, size_t *p_start, size_t *p_size);
+
+// Files a pointer of memory->p_pointers under the page its start is in, or takes it out of the index if it doesn't point anywhere.
+// Called after every change to the start of a pointer of memory->p_pointers, so a moved block finds its pointers (see pointer_index_move)
+//
+// Input : A pointer to the memory and a pointer struct of memory->p_pointers (not a copy, the lists link the structs themselves)
+//
+// Output : The pointer is in the list of the page of its start_index (moved there if it was in the list of another page),
+// or in no list if start_index is -1
+void pointer_index_update(Memory *p_memory, Pointer *p_ptr);
+
+// Takes a pointer out of the pointer index, before it is removed from memory->p_pointers (and freed)
+//
+// Input : A pointer to the memory and a pointer struct of memory->p_pointers
+//
+// Output : The pointer is in no list of memory->pp_pointer_index, does nothing if it wasn't in one
+void pointer_index_remove(Memory *p_memory, Pointer *p_ptr);
+
+// Moves the pointers into bytes that were moved, with the pointer index instead of a walk over memory->p_pointers
+//
+// Input : A pointer to the memory, where the bytes started, where they start now and how many there are
 //
-// Output : Initializes a new pointer struct into the pointer struct map
-void new_pointer(HashMap *p_pointer_map, char *name);
+// Output : Every pointer of memory->p_pointers that started in the old bytes keeps its offset inside them, at their new start.
+// Only checks the pointers in the pages of the old bytes
+void pointer_index_move(Memory *p_memory, size_t old_start, size_t new_start, size_t size);
 
 #endif // POINTER_MANAGEMENT_H
\ No newline at end of file
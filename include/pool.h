@@ -0,0 +1,55 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include "general_management.h"
+
+// The smallest object a pool can hold, a free object has to fit the index of the next free object
+#define POOL_MIN_OBJECT_SIZE sizeof(uint32_t)
+
+// Marks the end of the free list of a pool
+#define POOL_END_OF_LIST 0xFFFFFFFF
+
+// Arguments parser for the pool_create function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function pool_create if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status pool_create_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Creates a pool, a region that is split into <count> objects of <object_size> bytes (a slab)
+//
+// Input : A pointer to the memory, a name for the pool, the size of every object and the amount of objects
+//
+// Output : Carves one block of <object_size> * <count> bytes from the memory for the pool and links all the objects into its free list, 
+// returns a boolean (0 or 1) if it succeded or not
+uint8_t pool_create(Memory *p_memory, char *name, size_t object_size, size_t count);
+
+// Arguments parser for the pool_alloc function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function pool_alloc if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status pool_alloc_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Allocates one object from a pool by popping the head of its free list, in O(1)
+//
+// Input : A pointer to the memory, a pointer to the pool and a pointer to a pointer struct
+//
+// Output : Points <*p_ptr> at a free object of the pool and returns 1, or returns 0 if every object of the pool is allocated
+uint8_t pool_alloc(Memory *p_memory, Region *p_pool, Pointer *p_ptr);
+
+// Arguments parser for the pool_free function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function pool_free if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status pool_free_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Releases one object of a pool by pushing it to the head of the free list of the pool, in O(1)
+//
+// Input : A pointer to the memory and a pointer to a pointer struct that was allocated with pool_alloc
+//
+// Output : The object of the pointer can be allocated again, returns a boolean (0 or 1) if it succeded or not
+uint8_t pool_free(Memory *p_memory, Pointer *p_ptr);
+
+#endif // POOL_H
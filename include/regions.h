@@ -0,0 +1,33 @@
+#ifndef REGIONS_H
+#define REGIONS_H
+
+#include "general_management.h"
+
+// Names of the region types, for messages and visualize_blocks
+extern const char *arr_region_type_names[];
+
+// Names of the commands that release the allocations of each region type, for error messages
+extern const char *arr_region_release_commands[];
+
+// Carves a block for a new region out of the memory (with the allocator chosen at startup) and saves the region by its name
+//
+// Input : A pointer to the memory, the name of the new region, its type and the size of its block
+//
+// Output : Returns a pointer to the new region in memory->p_regions, or NULL (after printing an error) if the name is taken or there is not enough memory
+Region* create_region(Memory *p_memory, char *name, Region_Type type, size_t size);
+
+// Gets a region by its name, and makes sure it is of the type the command expects
+//
+// Input : A pointer to the memory, the name of the region and the type it should be
+//
+// Output : Returns a pointer to the region, or NULL (after printing an error) if there is no region of that type with that name
+Region* get_region(Memory *p_memory, char *name, Region_Type type);
+
+// Finds the region that owns a block, by going over all the regions (only used for visualization)
+//
+// Input : A pointer to the memory, the id of a block with the BLOCK_REGION state, and a pointer to where to put the region
+//
+// Output : Returns the name of the region and puts the region in *pp_region, or returns NULL if no region owns the block
+char* find_region_of_block(Memory *p_memory, BlockId block, Region **pp_region);
+
+#endif // REGIONS_H
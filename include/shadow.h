@@ -0,0 +1,80 @@
+#ifndef SHADOW_H
+#define SHADOW_H
+
+#include "general_management.h"
+
+// The shadow of the memory is one bit for every byte of p_bytes (bit i % 64 of word i / 64 is byte i), on if the byte was written
+// since its block was allocated. Free bytes always have their bit off, so a new allocation starts as garbage without touching it.
+// Ranges are set, cleared and tested a word (64 bytes of the memory) at a time
+
+// Calculates how many bytes the shadow of a memory takes
+//
+// Input : The size of the memory in bytes
+//
+// Output : Returns the size in bytes of the shadow (whole uint64_t words, one bit for every byte)
+size_t shadow_storage_size(size_t memory_size);
+
+// Marks bytes as written
+//
+// Input : The shadow, the index of the first byte and how many bytes
+//
+// Output : Their bits are on
+void shadow_set(uint64_t *p_shadow, size_t start, size_t size);
+
+// Marks bytes as garbage, like when their block is freed
+//
+// Input : The shadow, the index of the first byte and how many bytes
+//
+// Output : Their bits are off
+void shadow_clear(uint64_t *p_shadow, size_t start, size_t size);
+
+// Turns the bits of a range on or off, the words between the first and the last one are written with memset
+//
+// Input : The shadow, the index of the first byte, how many bytes and the value of the bits (0 or 1)
+//
+// Output : The bits of the range are <on>
+void shadow_fill(uint64_t *p_shadow, size_t start, size_t size, uint8_t on);
+
+// Finds the first byte of a range that was never written
+//
+// Input : The shadow, the index of the first byte and how many bytes
+//
+// Output : Returns the offset of the first byte whose bit is off from start, or size if all of them were written
+size_t shadow_find_unset(const uint64_t *p_shadow, size_t start, size_t size);
+
+// Counts the written bytes of a range
+//
+// Input : The shadow, the index of the first byte and how many bytes
+//
+// Output : Returns how many bits of the range are on
+size_t shadow_count(const uint64_t *p_shadow, size_t start, size_t size);
+
+// Copies the bits of a range to another range, of the same shadow (like memmove, they can overlap) or of another one
+//
+// Input : The shadow to copy to and the first bit there, the shadow to copy from and the first bit there, and how many bits
+//
+// Output : The bits of the destination are the bits the source had
+void shadow_copy(uint64_t *p_dst, size_t dst_start, const uint64_t *p_src, size_t src_start, size_t size);
+
+// Reads up to 64 bits that start anywhere in a shadow
+//
+// Input : The shadow, the first bit and how many bits (1-64)
+//
+// Output : Returns the bits, the first one is the lowest bit
+uint64_t shadow_read_bits(const uint64_t *p_shadow, size_t first, size_t count);
+
+// Writes up to 64 bits that start anywhere in a shadow, without changing the bits around them
+//
+// Input : The shadow, the first bit, how many bits (1-64) and their values (the first one is the lowest bit)
+//
+// Output : The bits are written
+void shadow_write_bits(uint64_t *p_shadow, size_t first, size_t count, uint64_t bits);
+
+// Checks that every byte a command reads was written, so garbage is never shown or used
+//
+// Input : A pointer to the memory, the index of the first byte and how many bytes
+//
+// Output : Returns a boolean (0 or 1) if all of them were written or not (after printing the address of the first one that wasn't)
+uint8_t shadow_check(Memory *p_memory, size_t start, size_t size);
+
+#endif // SHADOW_H
@@ -0,0 +1,112 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "general_management.h"
+
+// The first bytes of every snapshot file, and the version of the format after them
+#define SNAPSHOT_MAGIC "BYTHSNAP"
+#define SNAPSHOT_VERSION 2
+
+// Marks a pointer that is not from a region in Snapshot_Pointer.region
+#define SNAPSHOT_NO_REGION 0xFFFFFFFF
+
+// The start of a snapshot file. After it come (all in the byte order of the machine that saved it):
+// the size of every block (uint64_t, in the order of the linked list, the starts are the sums of the sizes before them),
+// the state of every block (uint8_t), a Snapshot_Region and its name for every region, a Snapshot_Pointer and its name for every pointer,
+// the image: the bytes of the allocated blocks one after the other (free blocks hold garbage, so they are skipped),
+// and last the shadow of the image: shadow_storage_size(image_size) bytes, the bits of the image's bytes in Memory.p_shadow
+typedef struct {
+    char arr_magic[8]; // SNAPSHOT_MAGIC, without the '\0'
+    uint32_t version; // SNAPSHOT_VERSION
+    uint32_t allocator; // The Allocator_Type the blocks were split by, it has to be the allocator of the memory that loads them
+    uint64_t memory_size; // The sum of the sizes of the blocks
+    uint64_t amount_of_blocks;
+    uint64_t amount_of_regions;
+    uint64_t amount_of_pointers;
+    uint64_t image_size; // The sum of the sizes of the allocated blocks
+} Snapshot_Header;
+
+// A Region in a snapshot file, followed by <name_length> chars of its name (without a '\0')
+typedef struct {
+    uint64_t block; // Index of its block in the order of the linked list (which is the id of the block after loading)
+    uint64_t used;
+    uint32_t type;
+    uint32_t generation;
+    uint32_t object_size;
+    uint32_t count;
+    uint32_t free_head;
+    uint32_t name_length;
+} Snapshot_Region;
+
+// A Pointer in a snapshot file, followed by <name_length> chars of its name (without a '\0')
+typedef struct {
+    int64_t start_index;
+    uint64_t size;
+    uint32_t region; // Index of its region in the order the regions were saved, SNAPSHOT_NO_REGION for the main memory
+    uint32_t generation;
+    uint32_t name_length;
+} Snapshot_Pointer;
+
+// Where every part of a snapshot file starts, after snapshot_parse checked that they are all valid
+typedef struct {
+    Snapshot_Header header;
+    const uint8_t *p_sizes; // amount_of_blocks uint64_t (read with memcpy, they might not be aligned)
+    const uint8_t *p_states; // amount_of_blocks uint8_t
+    const uint8_t *p_regions; // The first Snapshot_Region
+    const uint8_t *p_pointers; // The first Snapshot_Pointer
+    const uint8_t *p_image;
+    const uint8_t *p_image_shadow; // One bit for every byte of the image (read with memcpy, it might not be aligned)
+} Snapshot_View;
+
+// Arguments parser for the snapshot_save function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function snapshot_save if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status snapshot_save_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parser for the snapshot_load function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function snapshot_load if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status snapshot_load_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Writes the blocks, the regions, the pointers and the bytes of the allocated blocks to a file, so snapshot_load can restore them
+// without running the commands that made them again
+//
+// Input : A pointer to the memory and the path of the file
+//
+// Output : Writes the snapshot (see Snapshot_Header) and puts its size in *p_file_size, returns a boolean (0 or 1) if it succeded or not
+uint8_t snapshot_save(Memory *p_memory, const char *path, size_t *p_file_size);
+
+// Replaces the blocks, the regions and the pointers of the memory with the ones in a snapshot file
+//
+// Input : A pointer to the memory and the path of the file
+//
+// Output : Restores the snapshot, growing the memory if the snapshot is bigger (a smaller snapshot is followed by a free block),
+// returns a boolean (0 or 1) if it succeded or not (then the memory didn't change)
+uint8_t snapshot_load(Memory *p_memory, const char *path);
+
+// Checks that a snapshot file is whole and valid before anything in the memory is changed
+//
+// Input : A pointer to the bytes of the file, its size, the allocator of the memory and a pointer to where to put where every part starts
+//
+// Output : Fills *p_view and returns 1, or prints what is wrong and returns 0
+uint8_t snapshot_parse(const uint8_t *p_file, size_t file_size, Allocator_Type allocator, Snapshot_View *p_view);
+
+// Builds the block table, the block map, the bins, the regions and the pointers from a parsed snapshot, and copies the image
+//
+// Input : A pointer to the memory (at least as big as the snapshot) and a view that snapshot_parse filled
+//
+// Output : The memory is the memory that was saved, and free after the size of the snapshot
+void snapshot_restore(Memory *p_memory, const Snapshot_View *p_view);
+
+// Moves a cursor over the next part of a snapshot file
+//
+// Input : A pointer to the cursor, the end of the file and the size of the part
+//
+// Output : Returns where the part starts and moves the cursor after it, or NULL if the file ends before the part does
+const uint8_t* snapshot_skip(const uint8_t **pp_cursor, const uint8_t *p_end, size_t size);
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,36 @@
+#ifndef TLSF_H
+#define TLSF_H
+
+#include "general_management.h"
+
+// Gets the first level (power of two range) and second level (linear part of the range) of the TLSF list that a free block of <size> bytes belongs to
+//
+// Input : A size in bytes (must be more than 0), and pointers to where to put the two levels
+//
+// Output : *p_fl is floor(log2(size)), and *p_sl is which of the TLSF_SL_COUNT equal parts of [2^fl, 2^(fl+1)) the size is in
+void tlsf_mapping(size_t size, unsigned int *p_fl, unsigned int *p_sl);
+
+// Adds a free block to the head of its TLSF list and turns on the bits of the list in both bitmaps
+//
+// Input : A pointer to the memory and the id of a free block
+//
+// Output : The block is linked into memory->arr_tlsf_lists
+void tlsf_insert(Memory *p_memory, BlockId block);
+
+// Removes a free block from its TLSF list, and turns off the bits of the list if it became empty
+// Must be called before the size of the block changes, otherwise the wrong list is used
+//
+// Input : A pointer to the memory and the id of a free block that is in one of the lists
+//
+// Output : The block is unlinked from memory->arr_tlsf_lists
+void tlsf_remove(Memory *p_memory, BlockId block);
+
+// Finds a free block that can hold <size> bytes with two bitmap lookups, without looking at any block
+//
+// Input : A pointer to the memory and the size of the allocation
+//
+// Output : Returns the id of the head of the first non empty list whose blocks are all at least <size> bytes, 
+// or NO_BLOCK if there is no such list
+BlockId tlsf_find(Memory *p_memory, size_t size);
+
+#endif // TLSF_H
@@ -8,7 +8,11 @@
 #include <string.h>
 #include <stdint.h> // Using uint8_t in all the project
 #include <stdarg.h> // For the printlnf function which needs to accept multiple parameters like the printf function
+#ifdef _WIN32
 #include <windows.h> // For Sleep() in the exit animstion
+#else
+#include <unistd.h> // For usleep() in the exit animation
+#endif
 
 // printf with auto newline
 void printlnf(const char *format, ...); 
@@ -0,0 +1,140 @@
+#ifndef VECTOR_OPS_H
+#define VECTOR_OPS_H
+
+#include "general_management.h"
+
+// The count argument of the vector commands when it is left out: as many whole elements as fit in every pointer of the command
+#define VECTOR_WHOLE SIZE_MAX
+
+// What the elementwise commands do to every element of the destination (with the element of the source at the same index)
+typedef enum {
+    VEC_ADD = 0, // dst + src, wraps around like unsigned numbers in C
+    VEC_XOR = 1,
+    VEC_AND = 2,
+    VEC_OR = 3,
+    VEC_SHL = 4, // dst << bits, there is no source
+    AMOUNT_OF_VECTOR_OPS
+} Vector_Op;
+
+// What the reduction commands compute over the elements of a pointer
+typedef enum {
+    VEC_SUM = 0, // Wraps around at 64 bits
+    VEC_MIN = 1,
+    VEC_MAX = 2,
+    VEC_POPCOUNT = 3, // The amount of bits that are on
+    AMOUNT_OF_VECTOR_REDUCTIONS
+} Vector_Reduction;
+
+// The loops of the vector commands for one Bulk_Kernel_Type (the same kernel the bulk memory commands use).
+// A kernel returns 0 for an operation it has no instructions for (like the min of u32 elements in SSE2), and then the scalar kernel runs it
+typedef struct {
+    char *p_name;
+    // Applies op to <count> elements of <width> bytes, in the byte order of the machine unless <swap>, operand is the bits of VEC_SHL
+    uint8_t (*p_elementwise)(Vector_Op op, uint8_t width, uint8_t swap, uint8_t *p_dst, const uint8_t *p_src, uint64_t operand, size_t count);
+    // Folds <count> elements into *p_result (which starts as 0 for VEC_SUM and VEC_POPCOUNT, and as the first element for VEC_MIN and VEC_MAX)
+    uint8_t (*p_reduce)(Vector_Reduction reduction, uint8_t width, uint8_t swap, const uint8_t *p_src, size_t count, uint64_t *p_result);
+} Vector_Kernels;
+
+// Every kernel, by its Bulk_Kernel_Type
+extern const Vector_Kernels arr_vector_kernels[AMOUNT_OF_BULK_KERNELS];
+
+// The names of the operations and the reductions, for the messages of the commands
+extern const char *arr_vector_op_names[AMOUNT_OF_VECTOR_OPS];
+extern const char *arr_vector_reduction_names[AMOUNT_OF_VECTOR_REDUCTIONS];
+
+// Arguments parsers of the elementwise commands, all of them call vector_elementwise_command with their operation
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function vector_elementwise if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status vec_add_command(Memory *p_memory, int args_c, char *args[10]);
+Command_Status vec_xor_command(Memory *p_memory, int args_c, char *args[10]);
+Command_Status vec_and_command(Memory *p_memory, int args_c, char *args[10]);
+Command_Status vec_or_command(Memory *p_memory, int args_c, char *args[10]);
+Command_Status vec_shl_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parsers of the reduction commands, all of them call vector_reduce_command with their reduction
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function vector_reduce if all the arguments are valid, prints the result and returns how the command ended (see Command_Status)
+Command_Status vec_sum_command(Memory *p_memory, int args_c, char *args[10]);
+Command_Status vec_min_command(Memory *p_memory, int args_c, char *args[10]);
+Command_Status vec_max_command(Memory *p_memory, int args_c, char *args[10]);
+Command_Status vec_popcount_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parser for the vector_elementwise function
+//
+// Input : A pointer to the memory, the amount of arguments and the arguments (type, destination, source or bits, and the count)
+// and the operation
+//
+// Output : Calls the function vector_elementwise if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status vector_elementwise_command(Memory *p_memory, int args_c, char *args[10], Vector_Op op);
+
+// Arguments parser for the vector_reduce function
+//
+// Input : A pointer to the memory, the amount of arguments and the arguments (type, pointer and the count) and the reduction
+//
+// Output : Calls the function vector_reduce if all the arguments are valid, prints the result and returns how the command ended (see Command_Status)
+Command_Status vector_reduce_command(Memory *p_memory, int args_c, char *args[10], Vector_Reduction reduction);
+
+// Applies an operation to every element of what a pointer points at, with the element at the same index of another pointer
+//
+// Input : A pointer to the memory, the operation, the type, the destination and the source (the destination again for VEC_SHL),
+// the bits to shift by (VEC_SHL) and a pointer to how many elements (VECTOR_WHOLE for all that fit, then it is set to the amount)
+//
+// Output : The elements of the destination are changed, returns a boolean (0 or 1) if it succeded or not
+uint8_t vector_elementwise(Memory *p_memory, Vector_Op op, const Scalar_Type *p_type, uint8_t big_endian, Pointer dst, Pointer src,
+    uint64_t operand, size_t *p_count);
+
+// Computes a reduction over the elements of what a pointer points at
+//
+// Input : A pointer to the memory, the reduction, the type, the pointer, a pointer to how many elements (VECTOR_WHOLE for all that fit,
+// then it is set to the amount) and where to put the result
+//
+// Output : Puts the result in *p_result, returns a boolean (0 or 1) if it succeded or not
+uint8_t vector_reduce(Memory *p_memory, Vector_Reduction reduction, const Scalar_Type *p_type, uint8_t big_endian, Pointer ptr,
+    size_t *p_count, uint64_t *p_result);
+
+// Parses the type and the optional count of a vector command
+//
+// Input : The type argument, the count argument (NULL if it was not given), where to put the type, the byte order and the count,
+// and the name of the command
+//
+// Output : Returns a boolean (0 or 1) if they are valid or not (after printing an error)
+uint8_t parse_vector_arguments(const char *type_arg, const char *count_arg, const Scalar_Type **pp_type, uint8_t *p_big_endian,
+    size_t *p_count, const char *command);
+
+// Reads an element of <width> bytes
+//
+// Input : A pointer to the element, its width and if its bytes are in the opposite order of the machine
+//
+// Output : Returns the element
+uint64_t read_element(const uint8_t *p_element, uint8_t width, uint8_t swap);
+
+// Writes an element of <width> bytes
+//
+// Input : A pointer to the element, its width, if its bytes are in the opposite order of the machine, and its value (the lowest <width> bytes)
+//
+// Output : The element is written
+void write_element(uint8_t *p_element, uint8_t width, uint8_t swap, uint64_t value);
+
+// The kernels, with the signatures of Vector_Kernels.p_elementwise and Vector_Kernels.p_reduce
+//
+// Input : The operation, the width and byte order of the elements, the ranges, and the count
+//
+// Output : Returns 1 after running the operation, or 0 if the kernel has no loop for it
+
+// The scalar kernel, one element at a time, runs every operation in any byte order
+uint8_t elementwise_scalar(Vector_Op op, uint8_t width, uint8_t swap, uint8_t *p_dst, const uint8_t *p_src, uint64_t operand, size_t count);
+uint8_t reduce_scalar(Vector_Reduction reduction, uint8_t width, uint8_t swap, const uint8_t *p_src, size_t count, uint64_t *p_result);
+
+// The SSE2 kernel, 16 bytes at a time, no unsigned min and max of elements wider than a byte
+uint8_t elementwise_sse2(Vector_Op op, uint8_t width, uint8_t swap, uint8_t *p_dst, const uint8_t *p_src, uint64_t operand, size_t count);
+uint8_t reduce_sse2(Vector_Reduction reduction, uint8_t width, uint8_t swap, const uint8_t *p_src, size_t count, uint64_t *p_result);
+
+// The AVX2 kernel, 32 bytes at a time
+uint8_t elementwise_avx2(Vector_Op op, uint8_t width, uint8_t swap, uint8_t *p_dst, const uint8_t *p_src, uint64_t operand, size_t count);
+uint8_t reduce_avx2(Vector_Reduction reduction, uint8_t width, uint8_t swap, const uint8_t *p_src, size_t count, uint64_t *p_result);
+
+#endif // VECTOR_OPS_H
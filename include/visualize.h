@@ -14,22 +14,22 @@ typedef enum {
 //
 // Input : A pointer to the memory and the amount of arguments and the arguments
 //
-// Output : Calls the function visualize_bytes if all the arguments are valid
-void visualize_bytes_command(Memory *p_memory, int args_c, char *args[10]);
+// Output : Calls the function visualize_bytes if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status visualize_bytes_command(Memory *p_memory, int args_c, char *args[10]);
 
 // Shows the bytes array items as their hex format. Recommendation : Do not use over 1000 slots of memory if you want to use this function proprerly
 //
 // Input : A pointer to the memory
 //
-// Output : Prints all the items in the bytes array in the memory, based on their corresponding block as free, uninitialized, or with a value.
+// Output : Prints all the items in the bytes array in the memory, based on their corresponding block as free, or byte by byte as never written (from the shadow) or with a value.
 void visualize_bytes(Memory *p_mem);
 
 // Arguments parser for the visualize_blocks function
 //
 // Input : A pointer to the memory and the amount of arguments and the arguments
 //
-// Output : Calls the function visualize_blocks if all the arguments are valid
-void visualize_blocks_command(Memory *p_memory, int args_c, char *args[10]);
+// Output : Calls the function visualize_blocks if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status visualize_blocks_command(Memory *p_memory, int args_c, char *args[10]);
 
 // Show a list of the blocks and their metadata
 //
@@ -0,0 +1,83 @@
+#ifndef WATCH_H
+#define WATCH_H
+
+#include "general_management.h"
+
+// How many bytes of the memory one bit of Memory.p_watch_pages covers, a write to a page without a watchpoint is one bit test
+#define WATCH_PAGE_SIZE 4096
+
+// The most new bytes a watchpoint report shows, the rest are only counted
+#define WATCH_SHOWN_BYTES 16
+
+// A range of bytes that every write of a command is checked against, saved by the name of the pointer it was set on.
+// It moves with the bytes when their block moves (see watch_move), and is removed when they are freed (see watch_free)
+typedef struct {
+    size_t start; // Index in the bytes array of the first watched byte
+    size_t size;
+    uint64_t hits; // How many writes touched the range
+} Watchpoint;
+
+// Arguments parser for the watch_add function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function watch_add if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status watch_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Arguments parser for the watch_remove function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function watch_remove if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status unwatch_command(Memory *p_memory, int args_c, char *args[10]);
+
+// Sets a watchpoint on a range of bytes, a pointer has at most one (setting another one replaces it)
+//
+// Input : A pointer to the memory, the name of the pointer, the index of the first byte and how many bytes
+//
+// Output : Saves the watchpoint and turns on the bits of its pages
+void watch_add(Memory *p_memory, const char *name, size_t start, size_t size);
+
+// Removes the watchpoint of a pointer
+//
+// Input : A pointer to the memory and the name of the pointer
+//
+// Output : Returns a boolean (0 or 1) if the pointer had a watchpoint or not, the page bitmap is freed with the last watchpoint
+uint8_t watch_remove(Memory *p_memory, const char *name);
+
+// Builds the page bitmap again from the watchpoints, after one was added or removed or the memory grew
+//
+// Input : A pointer to the memory
+//
+// Output : Memory.p_watch_pages has the bits of the pages of every watchpoint, or is NULL if there are none
+void watch_rebuild_pages(Memory *p_memory);
+
+// Moves the watchpoints on bytes that moved to where the bytes are now, called by every path that moves bytes inside the memory
+//
+// Input : A pointer to the memory, the index the bytes were at, the index they are at now and how many bytes
+//
+// Output : Every watchpoint that starts in the moved bytes starts at the same offset from <new_start> (and is cut to the moved bytes)
+void watch_move(Memory *p_memory, size_t old_start, size_t new_start, size_t size);
+
+// Removes the watchpoints on bytes that were freed, called by every path that frees bytes
+//
+// Input : A pointer to the memory, the index of the first freed byte and how many bytes
+//
+// Output : Every watchpoint on the freed bytes is removed (after a report), or cut to the bytes of it that are still allocated
+void watch_free(Memory *p_memory, size_t start, size_t size);
+
+// Checks a write of a command against the watchpoints, called by every command that writes bytes after it wrote them
+//
+// Input : A pointer to the memory, the index of the first byte that was written, how many bytes and the name of the command
+//
+// Output : Reports the watchpoints the write touched (nothing at all is done if no watched page was written)
+void watch_write(Memory *p_memory, size_t start, size_t size, const char *p_command);
+
+// Prints a report for every watchpoint that a write touched
+//
+// Input : A pointer to the memory, the index of the first byte that was written, how many bytes and the name of the command
+//
+// Output : Prints the bytes the write changed in every watched range it touched, and counts the hits
+void watch_report(Memory *p_memory, size_t start, size_t size, const char *p_command);
+
+#endif // WATCH_H
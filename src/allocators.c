@@ -0,0 +1,64 @@
+#include "allocators.h"
+
+// Every allocator, by its Allocator_Type
+const Allocator arr_allocators[AMOUNT_OF_ALLOCATORS] = {
+    [BEST_FIT] = {"Best fit", "Checks every block on every malloc and takes the smallest one that fits, simple but slow with a lot of blocks", best_fit_find, NULL, NULL, NULL, 0, 1},
+    [SEGREGATED_FIT] = {"Segregated fit", "Keeps free blocks sorted into size classes, so malloc only checks blocks that are big enough", free_bins_find, NULL, NULL, NULL, 1, 1},
+    [BUDDY] = {"Buddy", "Rounds every allocation up to a power of two, wastes memory but malloc and free always take a few steps", NULL, buddy_malloc, buddy_free, buddy_init, 1, 0},
+    [TLSF] = {"TLSF", "Two levels of size classes, malloc and free take the same few steps no matter how many blocks there are", tlsf_find, NULL, NULL, NULL, 1, 1},
+    [FIRST_FIT] = {"First fit", "Takes the first block that fits, from the start of the memory", first_fit_find, NULL, NULL, NULL, 0, 1},
+    [NEXT_FIT] = {"Next fit", "Takes the first block that fits, from where the last malloc stopped", next_fit_find, NULL, NULL, NULL, 0, 1},
+    [WORST_FIT] = {"Worst fit", "Takes the biggest block, so what is left of it is as big as possible", worst_fit_find, NULL, NULL, NULL, 0, 1}
+};
+
+DEFINE_LIST_FIT_SCAN(first_fit, 1, 0) // Any block that fits is good enough
+DEFINE_LIST_FIT_SCAN(best_fit, curr_size == size, curr_size < best_size) // An exact fit can't be beaten
+DEFINE_LIST_FIT_SCAN(worst_fit, 0, curr_size > best_size) // Has to see every block
+
+// First fit policy: the first free block in memory that is big enough
+//
+// Input : A pointer to the memory and the size of the allocation
+//
+// Output : Returns the id of the free block to allocate in, or NO_BLOCK
+BlockId first_fit_find(Memory *p_memory, size_t size) {
+    return first_fit_scan(p_memory, size, p_memory->first_block, NO_BLOCK);
+}
+
+// Next fit policy: the first free block that is big enough, starting from where the last search stopped and wrapping around
+//
+// Input : A pointer to the memory and the size of the allocation
+//
+// Output : Returns the id of the free block to allocate in, or NO_BLOCK. The next search starts from it
+BlockId next_fit_find(Memory *p_memory, size_t size) {
+    BlockId rover = p_memory->next_fit_rover;
+    if (rover == NO_BLOCK) { // Nothing was searched yet
+        rover = p_memory->first_block;
+    }
+
+    BlockId found = first_fit_scan(p_memory, size, rover, NO_BLOCK); // From the rover until the end of the memory
+    if (found == NO_BLOCK) {
+        found = first_fit_scan(p_memory, size, p_memory->first_block, rover); // Wrap around to the start, until the rover
+    }
+    if (found != NO_BLOCK) {
+        p_memory->next_fit_rover = found;
+    }
+    return found;
+}
+
+// Best fit policy: the smallest free block that is big enough
+//
+// Input : A pointer to the memory and the size of the allocation
+//
+// Output : Returns the id of the free block to allocate in, or NO_BLOCK
+BlockId best_fit_find(Memory *p_memory, size_t size) {
+    return best_fit_scan(p_memory, size, p_memory->first_block, NO_BLOCK);
+}
+
+// Worst fit policy: the biggest free block, so the block that is left after the split is as big as possible
+//
+// Input : A pointer to the memory and the size of the allocation
+//
+// Output : Returns the id of the free block to allocate in, or NO_BLOCK
+BlockId worst_fit_find(Memory *p_memory, size_t size) {
+    return worst_fit_scan(p_memory, size, p_memory->first_block, NO_BLOCK);
+}
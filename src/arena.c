@@ -0,0 +1,127 @@
+#include "arena.h"
+
+// Arguments parser for the arena_create function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function arena_create if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status arena_create_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 2) {
+        print_error("Wrong amount of arguments for function arena_create. Expected 2 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    long size = strtol(args[1],&endptr,10); // Convert the string argument that user gave to a long based on decimal notation
+    if(*endptr != '\0' || size <= 0) { // Invalid input
+        print_error("Second argument in arena_create must be a positive integer (no decimal point) non zero number <size>");
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = arena_create(p_memory, args[0], (size_t)size);
+    if (success) {
+        print_success("Created arena %s with %ld bytes successfully.", args[0], size);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Creates an arena, a region that hands out allocations from the start of its block to its end (bump pointer)
+//
+// Input : A pointer to the memory, a name for the arena and the size of the arena in bytes
+//
+// Output : Carves one block of <size> bytes from the memory for the arena, returns a boolean (0 or 1) if it succeded or not
+uint8_t arena_create(Memory *p_memory, char *name, size_t size) {
+    return create_region(p_memory, name, ARENA, size) != NULL;
+}
+
+// Arguments parser for the arena_alloc function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function arena_alloc if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status arena_alloc_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 3) {
+        print_error("Wrong amount of arguments for function arena_alloc. Expected 3 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    Region *p_arena = get_region(p_memory, args[0], ARENA);
+    if (p_arena == NULL) {
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    long size = strtol(args[1],&endptr,10); // Convert the string argument that user gave to a long based on decimal notation
+    if(*endptr != '\0' || size <= 0) { // Invalid input
+        print_error("Second argument in arena_alloc must be a positive integer (no decimal point) non zero number <size>");
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_ptr = (Pointer*)hashmap_get(p_memory->p_pointers, args[2]);
+    if (p_ptr == NULL) { // Pointer does not exsist
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.",args[2]);
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = arena_alloc(p_memory, p_arena, (size_t)size, p_ptr);
+    pointer_index_update(p_memory, p_ptr); // Its start changed, so a block that moves finds it
+    if (success) {
+        print_success("Allocated %ld bytes from arena %s for pointer %s successfully.", size, args[0], args[2]);
+    } else {
+        print_error("Arena %s has only %zu bytes left, could not allocate %ld bytes.", args[0],
+            p_memory->blocks.p_sizes[p_arena->block] - p_arena->used, size);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Allocates <size> bytes from an arena by moving its bump pointer, no block is created and no block is searched for
+//
+// Input : A pointer to the memory, a pointer to the arena, the size of the allocation, and a pointer to a pointer struct
+//
+// Output : Points <*p_ptr> at the next <size> bytes of the arena and returns 1, or returns 0 if the arena doesn't have <size> bytes left
+uint8_t arena_alloc(Memory *p_memory, Region *p_arena, size_t size, Pointer *p_ptr) {
+    size_t arena_size = p_memory->blocks.p_sizes[p_arena->block];
+    if (size > arena_size - p_arena->used) { // Not enough bytes left
+        return 0;
+    }
+
+    p_ptr->start_index = (int64_t)(p_memory->blocks.p_start_indices[p_arena->block] + p_arena->used);
+    p_ptr->size = size;
+    p_ptr->p_region = p_arena;
+    p_ptr->generation = p_arena->generation; // Valid until the next arena_reset
+    p_arena->used += size;
+    return 1;
+}
+
+// Arguments parser for the arena_reset function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function arena_reset if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status arena_reset_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function arena_reset. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    Region *p_arena = get_region(p_memory, args[0], ARENA);
+    if (p_arena == NULL) {
+        return COMMAND_FAILED;
+    }
+    arena_reset(p_memory, p_arena);
+    print_success("Reset arena %s successfully, every pointer allocated from it is invalid now.", args[0]);
+    return COMMAND_SUCCEEDED;
+}
+
+// Releases every allocation of an arena at once, in O(1)
+//
+// Input : A pointer to the memory and a pointer to the arena
+//
+// Output : The bump pointer goes back to the start of the arena, and the generation of the arena goes up, 
+// so every pointer that was allocated from the arena before is invalid
+void arena_reset(Memory *p_memory, Region *p_arena) {
+    shadow_clear(p_memory->p_shadow, p_memory->blocks.p_start_indices[p_arena->block], p_arena->used); // Whatever was written in the arena is garbage now
+    watch_free(p_memory, p_memory->blocks.p_start_indices[p_arena->block], p_arena->used);
+    p_arena->used = 0;
+    p_arena->generation++; // Pointers are checked against this when they are used, so none of them has to be visited
+}
@@ -0,0 +1,239 @@
+#include "batch.h"
+
+// Arguments parser for the malloc_many function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function malloc_many if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status malloc_many_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 3) {
+        print_error("Wrong amount of arguments for function malloc_many. Expected 3 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    long count = strtol(args[0],&endptr,10); // Convert the string argument that user gave to a long based on decimal notation
+    if(*endptr != '\0' || count <= 0) { // Invalid input
+        print_error("First argument in malloc_many must be a positive integer (no decimal point) non zero number <count>");
+        return COMMAND_FAILED;
+    }
+
+    long size = strtol(args[1],&endptr,10);
+    if(*endptr != '\0' || size <= 0) { // Invalid input
+        print_error("Second argument in malloc_many must be a positive integer (no decimal point) non zero number <size>");
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = malloc_many(p_memory, (size_t)count, (size_t)size, args[2]);
+    if (success) {
+        print_success("Allocated %ld bytes for each of the pointers %s0 to %s%ld successfully.", size, args[2], args[2], count - 1);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Declares <count> pointers named <prefix>0 to <prefix><count - 1> and allocates <size> bytes for each of them,
+// with one search for a block of <count> * <size> bytes that is then split into <count> blocks in one pass
+//
+// Input : A pointer to the memory, the amount of pointers, the size of every allocation and the prefix of the names
+//
+// Output : Returns a boolean (0 or 1) if it succeded or not, if it didn't nothing was allocated and no pointer was declared
+uint8_t malloc_many(Memory *p_memory, size_t count, size_t size, char *prefix) {
+    char name[MAX_INPUT_SIZE + 21]; // The prefix and up to 20 digits
+    for (size_t i = 0; i < count; i++) { // Check every name first, so nothing has to be undone
+        snprintf(name, sizeof(name), "%s%zu", prefix, i);
+        if (hashmap_get(p_memory->p_pointers, name) != NULL) {
+            print_error("The pointer %s already exists, free it or choose another prefix.", name);
+            return 0;
+        }
+    }
+    if (count > p_memory->memory_size / size) { // Also makes sure count * size doesn't overflow
+        print_error("%zu allocations of %zu bytes are bigger than the memory.", count, size);
+        return 0;
+    }
+
+    Pointer **pp_ptrs = malloc(count * sizeof(Pointer*)); // Put the new pointers on the heap (so they can be used in the hashmap)
+    if (!pp_ptrs) {
+        fprintf(stderr, "Memory allocation failed for the pointer structs!\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < count; i++) {
+        pp_ptrs[i] = malloc(sizeof(Pointer));
+        if (!pp_ptrs[i]) {
+            fprintf(stderr, "Memory allocation failed for Pointer struct!\n");
+            exit(1);
+        }
+        *pp_ptrs[i] = (Pointer){.start_index = -1, .size = size, .p_region = NULL, .generation = 0};
+    }
+
+    uint8_t success = 1;
+    if (arr_allocators[p_memory->allocator].p_malloc) { // Blocks of allocators that split in their own way (buddy) can't be cut into any size
+        // The pointers are not in the hashmap yet, so a collection in my_malloc would free the blocks they already have
+        Gc_Mode gc_auto = p_memory->gc_auto;
+        p_memory->gc_auto = GC_OFF;
+        size_t allocated = 0;
+        while (allocated < count && my_malloc(p_memory, size, pp_ptrs[allocated])) {
+            allocated++;
+        }
+        p_memory->gc_auto = gc_auto;
+        if (allocated < count) { // Give back what was allocated, so it is all or nothing like the other allocators
+            for (size_t i = 0; i < allocated; i++) {
+                my_free(p_memory, &pp_ptrs[i]);
+            }
+            success = 0;
+        }
+    } else {
+        Pointer whole = {0}; // Only used to get the start of the block
+        success = my_malloc(p_memory, count * size, &whole);
+        if (success) {
+            split_into_blocks(p_memory, find_block(p_memory, (size_t)whole.start_index), size);
+            for (size_t i = 0; i < count; i++) {
+                pp_ptrs[i]->start_index = whole.start_index + (int64_t)(i * size);
+            }
+        }
+    }
+
+    if (!success) {
+        print_error("Could not allocate %zu blocks of %zu bytes.", count, size);
+        for (size_t i = 0; i < count; i++) {
+            free(pp_ptrs[i]);
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            snprintf(name, sizeof(name), "%s%zu", prefix, i);
+            hashmap_insert(p_memory->p_pointers, name, pp_ptrs[i], (uint8_t)1); // Names were checked above, so no warning is needed
+            pointer_index_update(p_memory, pp_ptrs[i]); // Only once it is in the hashmap, a pointer that is freed above is never indexed
+        }
+    }
+    free(pp_ptrs); // Only the array, the hashmap owns the pointers now
+    return success;
+}
+
+// Splits an allocated block into allocated blocks of <size> bytes that are next to each other
+//
+// Input : A pointer to the memory, the id of an allocated block, and a size that the size of the block is a multiple of
+//
+// Output : The block is the first <size> bytes, and every <size> bytes after it are a new allocated block
+void split_into_blocks(Memory *p_memory, BlockId block, size_t size) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    BlockId after = p_table->p_next[block]; // Chained after the last new block
+    size_t end = p_table->p_start_indices[block] + p_table->p_sizes[block];
+    p_table->p_sizes[block] = size;
+
+    BlockId last = block;
+    for (size_t start = p_table->p_start_indices[block] + size; start < end; start += size) {
+        BlockId new_block = take_block_slot(p_memory); // Can't fail, every block has at least one byte
+        p_table->p_sizes[new_block] = size;
+        p_table->p_start_indices[new_block] = start;
+        p_table->p_states[new_block] = 0; // Allocated, its bits in the shadow are off since it was free
+        p_table->p_next_free[new_block] = NO_BLOCK;
+        p_table->p_prev_free[new_block] = NO_BLOCK;
+        p_table->p_prev[new_block] = last;
+        p_table->p_next[last] = new_block;
+        block_map_insert(p_memory, new_block);
+        last = new_block;
+    }
+
+    p_table->p_next[last] = after;
+    if (after != NO_BLOCK) {
+        p_table->p_prev[after] = last;
+    }
+}
+
+// Arguments parser for the free_many function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function free_many if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status free_many_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function free_many. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    size_t amount_freed = free_many(p_memory, args[0]);
+    if (amount_freed == 0) {
+        print_error("There are no allocated pointers named %s followed by a number.", args[0]);
+        return COMMAND_FAILED;
+    }
+    print_success("Freed %zu pointers named %s followed by a number successfully.", amount_freed, args[0]);
+    return COMMAND_SUCCEEDED;
+}
+
+// Frees every pointer whose name is <prefix> followed by a number (like the ones malloc_many declares), 
+// and merges the free blocks with one sweep over the part of the memory they were in
+//
+// Input : A pointer to the memory and the prefix of the names
+//
+// Output : Returns how many pointers were freed (pointers that were not allocated, or that are from a region, are skipped)
+size_t free_many(Memory *p_memory, char *prefix) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    HashMap *p_pointers = p_memory->p_pointers;
+    void (*p_free)(Memory*, BlockId) = arr_allocators[p_memory->allocator].p_free; // Buddy blocks only merge with their buddy
+    size_t amount_freed = 0;
+    size_t lowest = SIZE_MAX, highest = 0; // The part of the memory that the freed blocks are in
+
+    for (size_t i = 0; i < p_pointers->bucket_size; i++) {
+        HashNode *p_node = p_pointers->pp_map[i];
+        while (p_node != NULL) {
+            HashNode *p_next_node = p_node->p_next; // The node might be removed
+            Pointer *p_ptr = (Pointer*)p_node->p_value;
+            BlockId block = NO_BLOCK;
+            if (is_batch_name(p_node->p_key, prefix) && p_ptr->p_region == NULL && p_ptr->start_index >= 0) {
+                block = find_block(p_memory, (size_t)p_ptr->start_index);
+            }
+
+            if (block != NO_BLOCK) {
+                if (p_free) {
+                    p_free(p_memory, block);
+                } else { // Only mark it free, the merging is done once for all of them below
+                    p_table->p_states[block] = BLOCK_FREE;
+                    shadow_clear(p_memory->p_shadow, p_table->p_start_indices[block], p_table->p_sizes[block]);
+                    watch_free(p_memory, p_table->p_start_indices[block], p_table->p_sizes[block]);
+                    free_bins_insert(p_memory, block);
+                    if (p_table->p_start_indices[block] < lowest) lowest = p_table->p_start_indices[block];
+                    if (p_table->p_start_indices[block] > highest) highest = p_table->p_start_indices[block];
+                }
+                pointer_index_remove(p_memory, p_ptr);
+                hashmap_remove(p_pointers, p_node->p_key, (uint8_t)1);
+                amount_freed++;
+            }
+            p_node = p_next_node;
+        }
+    }
+    if (p_free || amount_freed == 0) {
+        return amount_freed;
+    }
+
+    // One sweep from the block before the lowest freed block to the block after the highest one, merging every run of free blocks
+    BlockId curr = find_block_containing(p_memory, lowest);
+    if (p_table->p_prev[curr] != NO_BLOCK) {
+        curr = p_table->p_prev[curr];
+    }
+    while (curr != NO_BLOCK && p_table->p_start_indices[curr] <= highest) {
+        BlockId next = p_table->p_next[curr];
+        if ((p_table->p_states[curr] & BLOCK_FREE) && next != NO_BLOCK && (p_table->p_states[next] & BLOCK_FREE)) {
+            merge_block_right(p_memory, curr); // Stay on curr, it might be able to eat the next block too
+        } else {
+            curr = next;
+        }
+    }
+    return amount_freed;
+}
+
+// Checks if a name is a prefix followed by a number, like the names of the pointers that malloc_many declares
+//
+// Input : A name and a prefix
+//
+// Output : Returns a boolean (0 or 1) if the name is <prefix><number> or not
+uint8_t is_batch_name(const char *name, const char *prefix) {
+    size_t prefix_length = strlen(prefix);
+    if (strncmp(name, prefix, prefix_length) != 0 || name[prefix_length] == '\0') { // Needs at least one digit after the prefix
+        return 0;
+    }
+    for (const char *p_char = name + prefix_length; *p_char != '\0'; p_char++) {
+        if (*p_char < '0' || *p_char > '9') {
+            return 0;
+        }
+    }
+    return 1;
+}
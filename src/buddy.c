@@ -0,0 +1,152 @@
+#include "buddy.h"
+
+// Gets the order of the smallest buddy block that can hold <size> bytes
+//
+// Input : A size in bytes (must be more than 0)
+//
+// Output : Returns ceil(log2(size)), so a block of order k is 2^k bytes
+unsigned int buddy_order(size_t size) {
+    unsigned int order = size_class(size); // floor(log2(size))
+    if (size & (size - 1)) { // Not a power of two, so round up
+        order++;
+    }
+    return order;
+}
+
+// Halves a block that is not in any bin, the right half becomes a new free block
+//
+// Input : A pointer to the memory and the id of a block (with a power of two size) that is not in a bin
+//
+// Output : The block keeps the left half, the right half is a new free block in its bin. 
+// Returns a boolean (0 or 1) if it succeded or not
+uint8_t buddy_split(Memory *p_memory, BlockId block) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    BlockId buddy = take_block_slot(p_memory);
+    if (buddy == NO_BLOCK) {
+        print_error("Could not allocate memory: all slots are taken."); 
+        return 0;
+    }
+    size_t half = p_table->p_sizes[block] / 2;
+
+    p_table->p_sizes[block] = half;
+    p_table->p_sizes[buddy] = half;
+    p_table->p_start_indices[buddy] = p_table->p_start_indices[block] + half;
+    p_table->p_states[buddy] = BLOCK_FREE;
+
+    // Chain the buddy after the block
+    BlockId after = p_table->p_next[block];
+    p_table->p_next[buddy] = after;
+    p_table->p_prev[buddy] = block;
+    p_table->p_next[block] = buddy;
+    if (after != NO_BLOCK) {
+        p_table->p_prev[after] = buddy;
+    }
+
+    block_map_insert(p_memory, buddy); // So find_block can find the new block
+    free_bins_insert(p_memory, buddy);
+    return 1;
+}
+
+// Splits the whole memory (one free block) into the biggest power of two blocks that fit, from big to small,
+// so every block is aligned to its size, which buddy_free needs for finding the buddy of a block
+//
+// Input : A pointer to the memory, which has only one free block in it
+//
+// Output : The memory is made of free power of two blocks (one for every bit that is on in the memory size), all in the bins
+void buddy_init(Memory *p_memory) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    BlockId block = p_memory->first_block;
+    free_bins_remove(p_memory, block); // Its size is about to change
+
+    while (p_table->p_sizes[block] & (p_table->p_sizes[block] - 1)) { // While the last block is not a power of two
+        size_t top = (size_t)1 << size_class(p_table->p_sizes[block]); // Biggest power of two that fits
+
+        // Cut the biggest power of two from the start, and keep going on the rest
+        BlockId rest = take_block_slot(p_memory);
+        p_table->p_sizes[rest] = p_table->p_sizes[block] - top;
+        p_table->p_start_indices[rest] = p_table->p_start_indices[block] + top;
+        p_table->p_states[rest] = BLOCK_FREE;
+        p_table->p_sizes[block] = top;
+
+        p_table->p_next[rest] = NO_BLOCK; // It is always the last block
+        p_table->p_prev[rest] = block;
+        p_table->p_next[block] = rest;
+
+        block_map_insert(p_memory, rest);
+        free_bins_insert(p_memory, block);
+        block = rest;
+    }
+    free_bins_insert(p_memory, block);
+}
+
+// Allocates a block of the smallest power of two that can hold <size> bytes, 
+// by taking the smallest free block that is big enough and halving it until it is the right size
+//
+// Input : A pointer to the memory, a size of allocation, and a pointer to a pointer struct
+//
+// Output : Tries to allocate 2^buddy_order(size) bytes with pointer struct <*ptr>, 
+// and returns a boolean (0 or 1) if it succeded or not
+uint8_t buddy_malloc(Memory *p_memory, size_t size, Pointer *p_ptr) {
+    unsigned int order = buddy_order(size);
+    if (order >= AMOUNT_OF_SIZE_CLASSES) { // Bigger than any block can be
+        return 0;
+    }
+
+    // Every block in a bin has the exact size of the bin, so the lowest non empty bin from <order> up has the best block
+    uint64_t fitting_bins = p_memory->free_bins_bitmap & ~(((uint64_t)1 << order) - 1);
+    if (!fitting_bins) { // No free block is big enough
+        return 0;
+    }
+    BlockId block = p_memory->arr_free_bins[__builtin_ctzll(fitting_bins)];
+    free_bins_remove(p_memory, block);
+
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    while (p_table->p_sizes[block] > ((size_t)1 << order)) { // At most log2(memory size) halvings
+        if (!buddy_split(p_memory, block)) {
+            free_bins_insert(p_memory, block); // Give back what is left of the block, the halves that were split off stay free
+            return 0;
+        }
+    }
+
+    p_table->p_states[block] = 0; // Allocated, holds garbage values (its bits in the shadow are off since it was free)
+    p_ptr->start_index = (int64_t)p_table->p_start_indices[block];
+    return 1;
+}
+
+// Frees a block that was allocated by buddy_malloc, and merges it with its buddy as long as the buddy is free
+//
+// Input : A pointer to the memory and the id of an allocated block
+//
+// Output : The block (merged with all of its free buddies) is free and in the bin of its order
+void buddy_free(Memory *p_memory, BlockId block) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    p_table->p_states[block] = BLOCK_FREE;
+    shadow_clear(p_memory->p_shadow, p_table->p_start_indices[block], p_table->p_sizes[block]); // Free bytes hold garbage
+    watch_free(p_memory, p_table->p_start_indices[block], p_table->p_sizes[block]);
+    free_bins_insert(p_memory, block); // Every free block is in a bin, merging takes it out again
+
+    while (1) { // At most log2(memory size) merges, each one is O(1)
+        size_t size = p_table->p_sizes[block];
+        size_t start = p_table->p_start_indices[block];
+        size_t parent_start = start & ~(2 * size - 1);
+
+        // The parent only exists if it fits in one of the blocks buddy_init made,
+        // those blocks cover the memory up to the memory size without the bits lower than the parent's size
+        if ((size_t)parent_start + 2 * (size_t)size > (p_memory->memory_size & ~((size_t)2 * size - 1))) {
+            break;
+        }
+
+        // The buddy is right next to the block, the left one is before it and the right one is after it
+        BlockId left = (start == parent_start) ? block : p_table->p_prev[block];
+        BlockId right = (start == parent_start) ? p_table->p_next[block] : block;
+        BlockId buddy = (left == block) ? right : left;
+
+        // The buddy has to be whole (not split) and free
+        if (buddy == NO_BLOCK || p_table->p_sizes[buddy] != size || !(p_table->p_states[buddy] & BLOCK_FREE)) {
+            break;
+        }
+
+        merge_block_right(p_memory, left); // Left eats right, so the merged block is the parent (and it is put in the bin of its order)
+        block = left;
+    }
+}
@@ -0,0 +1,446 @@
+#include "bulk_memory.h"
+
+#include <errno.h> // For the range errors of strtoull()
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BULK_X86 // The SSE2 and AVX2 kernels only exist on x86, everything else runs the scalar kernel
+#include <immintrin.h>
+#endif
+
+const Bulk_Kernels arr_bulk_kernels[AMOUNT_OF_BULK_KERNELS] = {
+    [BULK_SCALAR] = {"scalar", fill_bytes_scalar, copy_bytes_scalar, compare_bytes_scalar},
+#ifdef BULK_X86
+    [BULK_SSE2] = {"SSE2", fill_bytes_sse2, copy_bytes_sse2, compare_bytes_sse2},
+    [BULK_AVX2] = {"AVX2", fill_bytes_avx2, copy_bytes_avx2, compare_bytes_avx2},
+#else
+    [BULK_SSE2] = {"scalar", fill_bytes_scalar, copy_bytes_scalar, compare_bytes_scalar}, // Never chosen by select_bulk_kernels
+    [BULK_AVX2] = {"scalar", fill_bytes_scalar, copy_bytes_scalar, compare_bytes_scalar},
+#endif
+};
+
+// Arguments parser for the bulk_set function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function bulk_set if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status mem_set_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 2 && args_c != 3) {
+        print_error("Wrong amount of arguments for function mem_set. Expected 2 or 3 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_ptr = (Pointer*)hashmap_get(p_memory->p_pointers, args[0]);
+    if (p_ptr == NULL) {
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.",args[0]);
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    long value = strtol(args[1],&endptr,10);
+    if (*endptr != '\0' || endptr == args[1] || value < 0 || value > 255) {
+        print_error("Second argument in mem_set must be an integer between 0-255 <byte>, not %s.", args[1]);
+        return COMMAND_FAILED;
+    }
+
+    size_t size;
+    if (!parse_bulk_size(args_c == 3 ? args[2] : NULL, &size, "mem_set")) {
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = bulk_set(p_memory, *p_ptr, (uint8_t)value, &size);
+    if (success) {
+        print_success("Set %zu bytes of pointer %s to %ld successfully.", size, args[0], value);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Arguments parser for the bulk_copy function, for ranges that don't overlap
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function bulk_copy if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status mem_copy_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 2 && args_c != 3) {
+        print_error("Wrong amount of arguments for function mem_copy. Expected 2 or 3 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_dst = (Pointer*)hashmap_get(p_memory->p_pointers, args[0]);
+    Pointer *p_src = (Pointer*)hashmap_get(p_memory->p_pointers, args[1]);
+    if (p_dst == NULL || p_src == NULL) {
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.", (p_dst == NULL) ? args[0] : args[1]);
+        return COMMAND_FAILED;
+    }
+
+    size_t size;
+    if (!parse_bulk_size(args_c == 3 ? args[2] : NULL, &size, "mem_copy")) {
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = bulk_copy(p_memory, *p_dst, *p_src, &size, 0);
+    if (success) {
+        print_success("Copied %zu bytes from pointer %s to pointer %s successfully.", size, args[1], args[0]);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Arguments parser for the bulk_copy function, for ranges that can overlap
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function bulk_copy if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status mem_move_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 2 && args_c != 3) {
+        print_error("Wrong amount of arguments for function mem_move. Expected 2 or 3 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_dst = (Pointer*)hashmap_get(p_memory->p_pointers, args[0]);
+    Pointer *p_src = (Pointer*)hashmap_get(p_memory->p_pointers, args[1]);
+    if (p_dst == NULL || p_src == NULL) {
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.", (p_dst == NULL) ? args[0] : args[1]);
+        return COMMAND_FAILED;
+    }
+
+    size_t size;
+    if (!parse_bulk_size(args_c == 3 ? args[2] : NULL, &size, "mem_move")) {
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = bulk_copy(p_memory, *p_dst, *p_src, &size, 1);
+    if (success) {
+        print_success("Moved %zu bytes from pointer %s to pointer %s successfully.", size, args[1], args[0]);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Arguments parser for the bulk_compare function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function bulk_compare if all the arguments are valid, prints where the bytes differ and returns how the command ended (see Command_Status)
+Command_Status mem_cmp_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 2 && args_c != 3) {
+        print_error("Wrong amount of arguments for function mem_cmp. Expected 2 or 3 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_first = (Pointer*)hashmap_get(p_memory->p_pointers, args[0]);
+    Pointer *p_second = (Pointer*)hashmap_get(p_memory->p_pointers, args[1]);
+    if (p_first == NULL || p_second == NULL) {
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.", (p_first == NULL) ? args[0] : args[1]);
+        return COMMAND_FAILED;
+    }
+
+    size_t size, difference;
+    if (!parse_bulk_size(args_c == 3 ? args[2] : NULL, &size, "mem_cmp")) {
+        return COMMAND_FAILED;
+    }
+    if (!bulk_compare(p_memory, *p_first, *p_second, &size, &difference)) {
+        return COMMAND_FAILED;
+    }
+
+    if (difference == size) {
+        print_success("The first %zu bytes of pointers %s and %s are the same.", size, args[0], args[1]);
+    } else {
+        print_success("Pointers %s and %s differ first at offset %zu (%02X and %02X).", args[0], args[1], difference,
+            p_memory->p_bytes[p_first->start_index + difference], p_memory->p_bytes[p_second->start_index + difference]);
+    }
+    return COMMAND_SUCCEEDED;
+}
+
+// Sets the first bytes a pointer points at to a value
+//
+// Input : A pointer to the memory, the pointer, the value and a pointer to how many bytes to set (BULK_WHOLE for all of them, then it is set to the amount)
+//
+// Output : Fills the bytes and marks them as written, returns a boolean (0 or 1) if it succeded or not
+uint8_t bulk_set(Memory *p_memory, Pointer dst, uint8_t value, size_t *p_size) {
+    size_t start, available;
+    if (resolve_pointer(p_memory, dst, &start, &available) == NO_BLOCK) { // Works for pointers to blocks and pointers into regions
+        return 0;
+    }
+
+    if (*p_size == BULK_WHOLE) {
+        *p_size = available;
+    }
+    if (*p_size > available) {
+        print_error("Can't set %zu bytes, the pointer at address %" PRId64 " points at %zu bytes.", *p_size, dst.start_index, available);
+        return 0;
+    }
+
+    arr_bulk_kernels[p_memory->bulk_kernels].p_fill(p_memory->p_bytes + start, value, *p_size);
+    shadow_set(p_memory->p_shadow, start, *p_size);
+    watch_write(p_memory, start, *p_size, "mem_set");
+    return 1;
+}
+
+// Copies the first bytes a pointer points at to the bytes another pointer points at
+//
+// Input : A pointer to the memory, the pointer to copy to, the pointer to copy from, a pointer to how many bytes (BULK_WHOLE for all of the source,
+// then it is set to the amount) and if the two ranges may overlap (memmove) or not (memcpy)
+//
+// Output : Copies the bytes and their bits in the shadow (garbage stays garbage), returns a boolean (0 or 1) if it succeded or not
+uint8_t bulk_copy(Memory *p_memory, Pointer dst, Pointer src, size_t *p_size, uint8_t allow_overlap) {
+    size_t dst_start, dst_size, src_start, src_size;
+    if (resolve_pointer(p_memory, src, &src_start, &src_size) == NO_BLOCK || resolve_pointer(p_memory, dst, &dst_start, &dst_size) == NO_BLOCK) {
+        return 0;
+    }
+
+    if (*p_size == BULK_WHOLE) {
+        *p_size = src_size;
+    }
+    if (*p_size > src_size || *p_size > dst_size) {
+        print_error("Can't copy %zu bytes, the source points at %zu bytes and the destination at %zu bytes.", *p_size, src_size, dst_size);
+        return 0;
+    }
+    if (!allow_overlap && *p_size > 0 && dst_start < src_start + *p_size && src_start < dst_start + *p_size) {
+        print_error("The %zu bytes at address %zu and at address %zu overlap, use mem_move to copy them.", *p_size, src_start, dst_start);
+        return 0;
+    }
+
+    arr_bulk_kernels[p_memory->bulk_kernels].p_copy(p_memory->p_bytes + dst_start, p_memory->p_bytes + src_start, *p_size);
+    shadow_copy(p_memory->p_shadow, dst_start, p_memory->p_shadow, src_start, *p_size); // Like memcpy in C, copying garbage is fine, using it is not
+    watch_write(p_memory, dst_start, *p_size, allow_overlap ? "mem_move" : "mem_copy");
+    return 1;
+}
+
+// Compares the first bytes two pointers point at
+//
+// Input : A pointer to the memory, the two pointers, a pointer to how many bytes (BULK_WHOLE for the smaller of the two, then it is set to the amount)
+// and where to put the index of the first byte that differs
+//
+// Output : Puts the index in *p_difference (the amount of bytes if they are all the same), returns a boolean (0 or 1) if it succeded or not
+uint8_t bulk_compare(Memory *p_memory, Pointer first, Pointer second, size_t *p_size, size_t *p_difference) {
+    size_t first_start, first_size, second_start, second_size;
+    if (resolve_pointer(p_memory, first, &first_start, &first_size) == NO_BLOCK || resolve_pointer(p_memory, second, &second_start, &second_size) == NO_BLOCK) {
+        return 0;
+    }
+
+    if (*p_size == BULK_WHOLE) {
+        *p_size = (first_size < second_size) ? first_size : second_size;
+    }
+    if (*p_size > first_size || *p_size > second_size) {
+        print_error("Can't compare %zu bytes, the pointers point at %zu and %zu bytes.", *p_size, first_size, second_size);
+        return 0;
+    }
+    if (!shadow_check(p_memory, first_start, *p_size) || !shadow_check(p_memory, second_start, *p_size)) { // Only the bytes that are compared
+        return 0;
+    }
+
+    *p_difference = arr_bulk_kernels[p_memory->bulk_kernels].p_compare(p_memory->p_bytes + first_start, p_memory->p_bytes + second_start, *p_size);
+    return 1;
+}
+
+// Parses the optional length argument of a bulk command
+//
+// Input : The argument (NULL if it was not given), where to put the length and the name of the command
+//
+// Output : Puts the length (BULK_WHOLE if there is no argument) in *p_size, returns a boolean (0 or 1) if it is valid or not
+uint8_t parse_bulk_size(const char *arg, size_t *p_size, const char *command) {
+    if (arg == NULL) {
+        *p_size = BULK_WHOLE;
+        return 1;
+    }
+
+    char *endptr;
+    errno = 0;
+    unsigned long long size = strtoull(arg, &endptr, 10);
+    if (*endptr != '\0' || endptr == arg || arg[0] == '-' || errno == ERANGE || size >= BULK_WHOLE) {
+        print_error("Third argument in %s must be a positive integer <length>, not %s.", command, arg);
+        return 0;
+    }
+    *p_size = (size_t)size;
+    return 1;
+}
+
+// Chooses the widest kernel the CPU supports, called once when the program starts
+//
+// Input : None
+//
+// Output : Returns BULK_AVX2, BULK_SSE2 or BULK_SCALAR
+Bulk_Kernel_Type select_bulk_kernels(void) {
+#ifdef BULK_X86
+    __builtin_cpu_init(); // Reads cpuid, main runs before anything else would
+    if (__builtin_cpu_supports("avx2")) {
+        return BULK_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return BULK_SSE2;
+    }
+#endif
+    return BULK_SCALAR;
+}
+
+// The scalar kernel, the C library already does these as well as a loop of bytes can
+void fill_bytes_scalar(uint8_t *p_dst, uint8_t value, size_t size) {
+    memset(p_dst, value, size);
+}
+
+void copy_bytes_scalar(uint8_t *p_dst, const uint8_t *p_src, size_t size) {
+    memmove(p_dst, p_src, size);
+}
+
+size_t compare_bytes_scalar(const uint8_t *p_first, const uint8_t *p_second, size_t size) {
+    for (size_t i = 0; i < size; i++) { // memcmp doesn't say where the bytes differ
+        if (p_first[i] != p_second[i]) {
+            return i;
+        }
+    }
+    return size;
+}
+
+#ifdef BULK_X86
+
+// The SSE2 kernel, 16 bytes at a time.
+// Ranges of 16 bytes or more start and end with an unaligned vector, and the vectors between them are aligned to the destination
+// (the first and last vectors overlap them, so no bytes are left for a loop of single bytes)
+__attribute__((target("sse2")))
+void fill_bytes_sse2(uint8_t *p_dst, uint8_t value, size_t size) {
+    if (size < 16) {
+        for (size_t i = 0; i < size; i++) {
+            p_dst[i] = value;
+        }
+        return;
+    }
+
+    __m128i vector = _mm_set1_epi8((char)value);
+    uint8_t *p_end = p_dst + size;
+    uint8_t *p_curr = (uint8_t*)(((uintptr_t)p_dst + 16) & ~(uintptr_t)15); // The first aligned address after the first vector starts
+    _mm_storeu_si128((__m128i*)p_dst, vector);
+    if (size >= BULK_STREAM_SIZE) {
+        for (; p_curr + 16 <= p_end; p_curr += 16) {
+            _mm_stream_si128((__m128i*)p_curr, vector);
+        }
+        _mm_sfence(); // Streaming stores are not ordered with the stores after them
+    } else {
+        for (; p_curr + 16 <= p_end; p_curr += 16) {
+            _mm_store_si128((__m128i*)p_curr, vector);
+        }
+    }
+    _mm_storeu_si128((__m128i*)(p_end - 16), vector);
+}
+
+// Like memmove: the first and the last vectors of the source are read before anything is written,
+// and the vectors between them are copied away from the side the destination overlaps the source from
+__attribute__((target("sse2")))
+void copy_bytes_sse2(uint8_t *p_dst, const uint8_t *p_src, size_t size) {
+    if (size < 16) {
+        memmove(p_dst, p_src, size);
+        return;
+    }
+
+    __m128i first = _mm_loadu_si128((const __m128i*)p_src);
+    __m128i last = _mm_loadu_si128((const __m128i*)(p_src + size - 16));
+    uint8_t *p_end = p_dst + size;
+    ptrdiff_t distance = p_src - p_dst; // The source of every destination address is this many bytes after it
+
+    if (p_dst <= p_src || p_dst >= p_src + size) { // Forward, every vector is read before the vectors before it are written over it
+        uint8_t *p_curr = (uint8_t*)(((uintptr_t)p_dst + 16) & ~(uintptr_t)15);
+        uint8_t stream = size >= BULK_STREAM_SIZE && (p_dst >= p_src + size || p_src >= p_end); // Streaming stores only when nothing is read back
+        if (stream) {
+            for (; p_curr + 16 <= p_end; p_curr += 16) {
+                _mm_stream_si128((__m128i*)p_curr, _mm_loadu_si128((const __m128i*)(p_curr + distance)));
+            }
+            _mm_sfence();
+        } else {
+            for (; p_curr + 16 <= p_end; p_curr += 16) {
+                _mm_store_si128((__m128i*)p_curr, _mm_loadu_si128((const __m128i*)(p_curr + distance)));
+            }
+        }
+    } else { // Backward, the destination starts inside the source
+        uint8_t *p_curr = (uint8_t*)((uintptr_t)p_end & ~(uintptr_t)15);
+        for (; p_curr >= p_dst + 16; p_curr -= 16) {
+            _mm_store_si128((__m128i*)(p_curr - 16), _mm_loadu_si128((const __m128i*)(p_curr - 16 + distance)));
+        }
+    }
+    _mm_storeu_si128((__m128i*)p_dst, first);
+    _mm_storeu_si128((__m128i*)(p_end - 16), last);
+}
+
+__attribute__((target("sse2")))
+size_t compare_bytes_sse2(const uint8_t *p_first, const uint8_t *p_second, size_t size) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i same = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p_first + i)), _mm_loadu_si128((const __m128i*)(p_second + i)));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(same); // Bit j is on if byte j is the same
+        if (mask != 0xFFFF) {
+            return i + (size_t)__builtin_ctz(~mask);
+        }
+    }
+    return i + compare_bytes_scalar(p_first + i, p_second + i, size - i);
+}
+
+// The AVX2 kernel, 32 bytes at a time, the same loops as the SSE2 kernel
+__attribute__((target("avx2")))
+void fill_bytes_avx2(uint8_t *p_dst, uint8_t value, size_t size) {
+    if (size < 32) {
+        fill_bytes_sse2(p_dst, value, size);
+        return;
+    }
+
+    __m256i vector = _mm256_set1_epi8((char)value);
+    uint8_t *p_end = p_dst + size;
+    uint8_t *p_curr = (uint8_t*)(((uintptr_t)p_dst + 32) & ~(uintptr_t)31);
+    _mm256_storeu_si256((__m256i*)p_dst, vector);
+    if (size >= BULK_STREAM_SIZE) {
+        for (; p_curr + 32 <= p_end; p_curr += 32) {
+            _mm256_stream_si256((__m256i*)p_curr, vector);
+        }
+        _mm_sfence();
+    } else {
+        for (; p_curr + 32 <= p_end; p_curr += 32) {
+            _mm256_store_si256((__m256i*)p_curr, vector);
+        }
+    }
+    _mm256_storeu_si256((__m256i*)(p_end - 32), vector);
+}
+
+__attribute__((target("avx2")))
+void copy_bytes_avx2(uint8_t *p_dst, const uint8_t *p_src, size_t size) {
+    if (size < 32) {
+        copy_bytes_sse2(p_dst, p_src, size);
+        return;
+    }
+
+    __m256i first = _mm256_loadu_si256((const __m256i*)p_src);
+    __m256i last = _mm256_loadu_si256((const __m256i*)(p_src + size - 32));
+    uint8_t *p_end = p_dst + size;
+    ptrdiff_t distance = p_src - p_dst;
+
+    if (p_dst <= p_src || p_dst >= p_src + size) {
+        uint8_t *p_curr = (uint8_t*)(((uintptr_t)p_dst + 32) & ~(uintptr_t)31);
+        uint8_t stream = size >= BULK_STREAM_SIZE && (p_dst >= p_src + size || p_src >= p_end);
+        if (stream) {
+            for (; p_curr + 32 <= p_end; p_curr += 32) {
+                _mm256_stream_si256((__m256i*)p_curr, _mm256_loadu_si256((const __m256i*)(p_curr + distance)));
+            }
+            _mm_sfence();
+        } else {
+            for (; p_curr + 32 <= p_end; p_curr += 32) {
+                _mm256_store_si256((__m256i*)p_curr, _mm256_loadu_si256((const __m256i*)(p_curr + distance)));
+            }
+        }
+    } else {
+        uint8_t *p_curr = (uint8_t*)((uintptr_t)p_end & ~(uintptr_t)31);
+        for (; p_curr >= p_dst + 32; p_curr -= 32) {
+            _mm256_store_si256((__m256i*)(p_curr - 32), _mm256_loadu_si256((const __m256i*)(p_curr - 32 + distance)));
+        }
+    }
+    _mm256_storeu_si256((__m256i*)p_dst, first);
+    _mm256_storeu_si256((__m256i*)(p_end - 32), last);
+}
+
+__attribute__((target("avx2")))
+size_t compare_bytes_avx2(const uint8_t *p_first, const uint8_t *p_second, size_t size) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i same = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p_first + i)), _mm256_loadu_si256((const __m256i*)(p_second + i)));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(same);
+        if (mask != 0xFFFFFFFF) {
+            return i + (size_t)__builtin_ctz(~mask);
+        }
+    }
+    return i + compare_bytes_sse2(p_first + i, p_second + i, size - i);
+}
+
+#endif // BULK_X86
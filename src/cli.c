@@ -19,6 +19,41 @@ HashMap init_commands(size_t size) {
         "Free an allocated pointer, for exmaple : free ptr",
         Memory_management
     );
+    Command my_realloc_cmd = create_cmd(
+        2,
+        (Command_Func)my_realloc_command,
+        "realloc",
+        "Change the size of an allocated pointer and keep its bytes, for example : realloc 20 ptr",
+        Memory_management
+    );
+    Command malloc_many_cmd = create_cmd(
+        3,
+        (Command_Func)malloc_many_command,
+        "malloc_many",
+        "Declare pointers named a prefix and a number and allocate the same size for all of them, for example : malloc_many 100 8 node",
+        Memory_management
+    );
+    Command free_many_cmd = create_cmd(
+        1,
+        (Command_Func)free_many_command,
+        "free_many",
+        "Free every pointer named a prefix and a number, for example : free_many node",
+        Memory_management
+    );
+    Command gc_cmd = create_cmd(
+        1,
+        (Command_Func)gc_command,
+        "gc",
+        "Free every block that no pointer can reach, 1 to only follow pointers or 2 to also scan bytes, for example : gc 1",
+        Memory_management
+    );
+    Command gc_auto_cmd = create_cmd(
+        1,
+        (Command_Func)gc_auto_command,
+        "gc_auto",
+        "Collect garbage when malloc can't find a free block, 0 for off, 1 or 2 like gc, for example : gc_auto 1",
+        Memory_management
+    );
 
     Command set_val_cmd = create_cmd(
         2,
@@ -29,6 +64,129 @@ HashMap init_commands(size_t size) {
         Memory_management
     );
 
+    Command store_cmd = create_cmd(
+        3,
+        (Command_Func)store_command,
+        "store",
+        "Write a number as a type (u8, u16, u32, u64, f32 or f64, with le or be for the byte order) into a pointer, at an optional offset, "
+        "for example : store u32le 70000 ptr 4",
+        Memory_management
+    );
+    store_cmd.amount_of_optional_arguments = 1; // The offset
+    Command load_cmd = create_cmd(
+        2,
+        (Command_Func)load_command,
+        "load",
+        "Read a number of a type (like store) from a pointer, at an optional offset, for example : load u32le ptr 4",
+        Memory_management
+    );
+    load_cmd.amount_of_optional_arguments = 1; // The offset
+
+    Command mem_set_cmd = create_cmd(
+        2,
+        (Command_Func)mem_set_command,
+        "mem_set",
+        "Set the bytes of a pointer to a value (0-255), all of them or an optional length, for example : mem_set buffer 0 4096",
+        Memory_management
+    );
+    mem_set_cmd.amount_of_optional_arguments = 1; // The length
+    Command mem_copy_cmd = create_cmd(
+        2,
+        (Command_Func)mem_copy_command,
+        "mem_copy",
+        "Copy the bytes of the second pointer to the first one (they can't overlap), all of them or an optional length, for example : mem_copy dst src 64",
+        Memory_management
+    );
+    mem_copy_cmd.amount_of_optional_arguments = 1;
+    Command mem_move_cmd = create_cmd(
+        2,
+        (Command_Func)mem_move_command,
+        "mem_move",
+        "Like mem_copy, but the bytes can overlap (like two pointers into one arena), for example : mem_move dst src 64",
+        Memory_management
+    );
+    mem_move_cmd.amount_of_optional_arguments = 1;
+    Command mem_cmp_cmd = create_cmd(
+        2,
+        (Command_Func)mem_cmp_command,
+        "mem_cmp",
+        "Compare the bytes of two pointers and show the first one that differs, for example : mem_cmp a b 64",
+        Memory_management
+    );
+    mem_cmp_cmd.amount_of_optional_arguments = 1;
+    Command vec_add_cmd = create_cmd(
+        3,
+        (Command_Func)vec_add_command,
+        "vec_add",
+        "Add the elements of the second pointer to the elements of the first one (wrapping around), all that fit or an optional count, for example : vec_add u32le dst src 16",
+        Memory_management
+    );
+    vec_add_cmd.amount_of_optional_arguments = 1; // The count
+    Command vec_xor_cmd = create_cmd(
+        3,
+        (Command_Func)vec_xor_command,
+        "vec_xor",
+        "Xor the elements of the second pointer into the elements of the first one, for example : vec_xor u64le dst src",
+        Memory_management
+    );
+    vec_xor_cmd.amount_of_optional_arguments = 1;
+    Command vec_and_cmd = create_cmd(
+        3,
+        (Command_Func)vec_and_command,
+        "vec_and",
+        "And the elements of the second pointer into the elements of the first one, for example : vec_and u8le dst mask",
+        Memory_management
+    );
+    vec_and_cmd.amount_of_optional_arguments = 1;
+    Command vec_or_cmd = create_cmd(
+        3,
+        (Command_Func)vec_or_command,
+        "vec_or",
+        "Or the elements of the second pointer into the elements of the first one, for example : vec_or u16be dst src 8",
+        Memory_management
+    );
+    vec_or_cmd.amount_of_optional_arguments = 1;
+    Command vec_shl_cmd = create_cmd(
+        3,
+        (Command_Func)vec_shl_command,
+        "vec_shl",
+        "Shift every element of a pointer left by a number of bits, for example : vec_shl u32le ptr 3",
+        Memory_management
+    );
+    vec_shl_cmd.amount_of_optional_arguments = 1;
+    Command vec_sum_cmd = create_cmd(
+        2,
+        (Command_Func)vec_sum_command,
+        "vec_sum",
+        "Show the sum of the elements of a pointer, all that fit or an optional count, for example : vec_sum u16le ptr 100",
+        Memory_management
+    );
+    vec_sum_cmd.amount_of_optional_arguments = 1;
+    Command vec_min_cmd = create_cmd(
+        2,
+        (Command_Func)vec_min_command,
+        "vec_min",
+        "Show the smallest element of a pointer, for example : vec_min u32le ptr",
+        Memory_management
+    );
+    vec_min_cmd.amount_of_optional_arguments = 1;
+    Command vec_max_cmd = create_cmd(
+        2,
+        (Command_Func)vec_max_command,
+        "vec_max",
+        "Show the biggest element of a pointer, for example : vec_max u64be ptr",
+        Memory_management
+    );
+    vec_max_cmd.amount_of_optional_arguments = 1;
+    Command vec_popcount_cmd = create_cmd(
+        2,
+        (Command_Func)vec_popcount_command,
+        "vec_popcount",
+        "Show how many bits are on in the elements of a pointer, for example : vec_popcount u8le ptr",
+        Memory_management
+    );
+    vec_popcount_cmd.amount_of_optional_arguments = 1;
+
     Command new_pointer_cmd = create_cmd(
         1,
         (Command_Func)new_pointer_command,
@@ -68,9 +226,171 @@ HashMap init_commands(size_t size) {
         Memory_management
     );
 
-    #define AMOUNT_OF_CMDS 8 // Macro down here so I remember to edit this number when adding new command until json automation
+    Command arena_create_cmd = create_cmd(
+        2,
+        (Command_Func)arena_create_command,
+        "arena_create",
+        "Carve a block of memory for an arena that allocates with a bump pointer, for example : arena_create scratch 100",
+        Memory_management
+    );
+    Command arena_alloc_cmd = create_cmd(
+        3,
+        (Command_Func)arena_alloc_command,
+        "arena_alloc",
+        "Allocate bytes for a pointer from an arena, for example : arena_alloc scratch 10 ptr",
+        Memory_management
+    );
+    Command arena_reset_cmd = create_cmd(
+        1,
+        (Command_Func)arena_reset_command,
+        "arena_reset",
+        "Release everything allocated from an arena at once, for example : arena_reset scratch",
+        Memory_management
+    );
+
+    Command pool_create_cmd = create_cmd(
+        3,
+        (Command_Func)pool_create_command,
+        "pool_create",
+        "Carve a block of memory for a pool of same sized objects, for example : pool_create nodes 8 20",
+        Memory_management
+    );
+    Command pool_alloc_cmd = create_cmd(
+        2,
+        (Command_Func)pool_alloc_command,
+        "pool_alloc",
+        "Allocate one object for a pointer from a pool, for example : pool_alloc nodes ptr",
+        Memory_management
+    );
+    Command pool_free_cmd = create_cmd(
+        1,
+        (Command_Func)pool_free_command,
+        "pool_free",
+        "Release an object that was allocated from a pool, for example : pool_free ptr",
+        Memory_management
+    );
+
+    Command nursery_create_cmd = create_cmd(
+        2,
+        (Command_Func)nursery_create_command,
+        "nursery_create",
+        "Carve a block of memory that malloc hands small allocations out of, for example : nursery_create 256 16",
+        Memory_management
+    );
+    Command nursery_collect_cmd = create_cmd(
+        0,
+        (Command_Func)nursery_collect_command,
+        "nursery_collect",
+        "Move every pointer that is still in the nursery to the main memory and empty the nursery",
+        Memory_management
+    );
+
+    Command compact_cmd = create_cmd(
+        0,
+        (Command_Func)compact_command,
+        "compact",
+        "Move every allocated block to the start of the memory, so all the free memory is one block",
+        Memory_management
+    );
+    Command defrag_cmd = create_cmd(
+        1,
+        (Command_Func)defrag_command,
+        "defrag",
+        "Move up to a number of bytes of blocks after every command to slowly defragment the memory (0 to turn it off), for example : defrag 64",
+        Memory_management
+    );
+
+    Command grow_cmd = create_cmd(
+        1,
+        (Command_Func)grow_command,
+        "grow",
+        "Add a number of free bytes to the end of the memory (not on the stack), for example : grow 1024",
+        Memory_management
+    );
+    Command grow_limit_cmd = create_cmd(
+        1,
+        (Command_Func)grow_limit_command,
+        "grow_limit",
+        "Grow the memory up to a size when malloc can't find a free block (0 to turn it off), for example : grow_limit 65536",
+        Memory_management
+    );
+
+    Command snapshot_save_cmd = create_cmd(
+        1,
+        (Command_Func)snapshot_save_command,
+        "snapshot_save",
+        "Save the blocks, regions, pointers and allocated bytes to a file, for example : snapshot_save warm.snap",
+        Memory_management
+    );
+    Command snapshot_load_cmd = create_cmd(
+        1,
+        (Command_Func)snapshot_load_command,
+        "snapshot_load",
+        "Replace the blocks, regions and pointers with the ones saved in a file, for example : snapshot_load warm.snap",
+        Memory_management
+    );
+
+    Command fork_cmd = create_cmd(
+        1,
+        (Command_Func)fork_command,
+        "fork",
+        "Keep a copy-on-write copy of the memory as it is now to switch to later (Linux only), for example : fork before_free",
+        Memory_management
+    );
+    Command switch_cmd = create_cmd(
+        1,
+        (Command_Func)switch_command,
+        "switch",
+        "Continue from a fork (the first memory is main), the fork you leave stays as it is, for example : switch before_free",
+        Memory_management
+    );
+    Command drop_cmd = create_cmd(
+        1,
+        (Command_Func)drop_command,
+        "drop",
+        "Delete a fork that is not in use, for example : drop before_free",
+        Memory_management
+    );
+
+    Command journal_cmd = create_cmd(
+        1,
+        (Command_Func)journal_command,
+        "journal",
+        "Record the commands that change the memory to a file (off to stop), so recover can rebuild the memory after a crash, for example : journal run.jrnl",
+        Memory_management
+    );
+    Command recover_cmd = create_cmd(
+        1,
+        (Command_Func)recover_command,
+        "recover",
+        "Load the snapshot a journal starts from and run the commands in it again, for example : recover run.jrnl",
+        ALL
+    );
+
+    Command watch_cmd = create_cmd(
+        1,
+        (Command_Func)watch_command,
+        "watch",
+        "Report every write of a command to the bytes of a pointer, all of them or from an optional offset and length, for example : watch ptr 4 2",
+        Memory_management
+    );
+    watch_cmd.amount_of_optional_arguments = 2; // The offset and the length
+    Command unwatch_cmd = create_cmd(
+        1,
+        (Command_Func)unwatch_command,
+        "unwatch",
+        "Stop reporting the writes to the bytes of a pointer, for example : unwatch ptr",
+        Memory_management
+    );
+
+    #define AMOUNT_OF_CMDS 49 // Macro down here so I remember to edit this number when adding new command until json automation
     // Initialize this command array 
-    Command commands[AMOUNT_OF_CMDS] = {my_malloc_cmd, my_free_cmd, set_val_cmd, new_pointer_cmd, help_cmd, exit_cmd, visualize_blocks_cmd, visualize_bytes_cmd};
+    Command commands[AMOUNT_OF_CMDS] = {my_malloc_cmd, my_free_cmd, my_realloc_cmd, malloc_many_cmd, free_many_cmd, gc_cmd, gc_auto_cmd, set_val_cmd, store_cmd, load_cmd, mem_set_cmd, mem_copy_cmd, mem_move_cmd, mem_cmp_cmd,
+                                        vec_add_cmd, vec_xor_cmd, vec_and_cmd, vec_or_cmd, vec_shl_cmd, vec_sum_cmd, vec_min_cmd, vec_max_cmd, vec_popcount_cmd, new_pointer_cmd, help_cmd, exit_cmd, visualize_blocks_cmd, visualize_bytes_cmd,
+                                        arena_create_cmd, arena_alloc_cmd, arena_reset_cmd, pool_create_cmd, pool_alloc_cmd, pool_free_cmd,
+                                        nursery_create_cmd, nursery_collect_cmd, compact_cmd, defrag_cmd, grow_cmd, grow_limit_cmd, snapshot_save_cmd, snapshot_load_cmd,
+                                        fork_cmd, switch_cmd, drop_cmd, journal_cmd, recover_cmd,
+                                        watch_cmd, unwatch_cmd};
 
     for (size_t i = 0; i < AMOUNT_OF_CMDS; i++) {
         Command *curr = malloc(sizeof(Command)); //  Heap allocation for the commands
@@ -98,6 +418,7 @@ HashMap init_commands(size_t size) {
 Command create_cmd(size_t amount_of_arguments, Command_Func func, const char *name, const char *description, Command_Classification type_of_function) {
     Command cmd;
     cmd.amount_of_arguments = amount_of_arguments;
+    cmd.amount_of_optional_arguments = 0; // Set after create_cmd for the few commands that have them
     switch(type_of_function) {
         case ALL:
             cmd.ALL_cmd = (ALL_Command_Func)func;
@@ -162,15 +483,23 @@ void execute_command(Memory *p_memory, HashMap *p_commands, char *input){
     }
 
     // Check argument count (excluding command name)
-    if (args_c - 1 != p_cmd->amount_of_arguments) {
-        print_error("Wrong amount of arguments ( %d ) for %s. Expected %d args.", args_c - 1, p_cmd->p_name, p_cmd->amount_of_arguments);
+    if ((size_t)(args_c - 1) < p_cmd->amount_of_arguments || (size_t)(args_c - 1) > p_cmd->amount_of_arguments + p_cmd->amount_of_optional_arguments) {
+        if (p_cmd->amount_of_optional_arguments == 0) {
+            print_error("Wrong amount of arguments ( %d ) for %s. Expected %d args.", args_c - 1, p_cmd->p_name, p_cmd->amount_of_arguments);
+        } else {
+            print_error("Wrong amount of arguments ( %d ) for %s. Expected %zu to %zu args.", args_c - 1, p_cmd->p_name, p_cmd->amount_of_arguments,
+                p_cmd->amount_of_arguments + p_cmd->amount_of_optional_arguments);
+        }
         return;
     }
 
     // Execute the command function
     if (p_cmd->memo_cmd) {
         if(p_cmd->type_of_function == Memory_management && p_cmd->memo_cmd){
-            p_cmd->memo_cmd(p_memory, args_c - 1, args + 1);  // Exclude command name and use the args array excluding the command name
+            Command_Status status = p_cmd->memo_cmd(p_memory, args_c - 1, args + 1);  // Exclude command name and use the args array excluding the command name
+            if (status != COMMAND_CANCELED) {
+                journal_after_command(p_memory, args_c, args, status == COMMAND_SUCCEEDED);
+            }
             return;
         }
         else if (p_cmd->type_of_function == Command_managment && p_cmd->hashmap_cmd){
@@ -241,7 +570,11 @@ void help_cmds(HashMap *p_map) {
 
                 printlnf("Command Name : %s", p_cmd->p_name);
                 printlnf("Command Description : %s", p_cmd->p_description);
-                printlnf("Amount of arguments : %d", p_cmd->amount_of_arguments);
+                if (p_cmd->amount_of_optional_arguments == 0) {
+                    printlnf("Amount of arguments : %d", p_cmd->amount_of_arguments);
+                } else {
+                    printlnf("Amount of arguments : %zu (and up to %zu optional)", p_cmd->amount_of_arguments, p_cmd->amount_of_optional_arguments);
+                }
                 printlnf("Management type : %s", management_type);
                 printlnf("-------------------------------------------------------------------------------------------");
             }
@@ -256,12 +589,37 @@ void exit_program_bytethon(Memory *p_memory, HashMap *p_cmds, int args_c, char *
     free_cmds(p_cmds); // Frees the pointers to the name and description of the commmands, but not the nodes themselves
     hashmap_free(p_cmds); // Frees the whole hashmap (including all nodes)
     hashmap_free(p_memory->p_pointers); // Frees the whole hashmap (including all nodes)
+    hashmap_free(p_memory->p_regions); // Frees the whole hashmap (including all nodes)
+    hashmap_free(p_memory->p_watches); // Frees the whole hashmap (including all nodes)
+    free(p_memory->p_watch_pages);
+    p_memory->p_watch_pages = NULL;
+    if (p_memory->journal.p_file != NULL) {
+        journal_stop(p_memory); // Syncs the records that are waiting for the next group sync
+    }
+    drop_all_forks(p_memory); // The other forks would exit by themselves after a second, but their pages are given back now
 
-    if (p_memory->on_heap) {
-        free(p_memory->p_blocks);
-        p_memory->p_blocks = NULL;
+    if (p_memory->backing == HEAP_BACKED) {
+        free(p_memory->blocks.p_sizes); // The sizes array is at the start of the block table's storage, so this frees every array of the table
+        p_memory->blocks.p_sizes = NULL;
         free(p_memory->p_bytes);
         p_memory->p_bytes = NULL;
+        free(p_memory->p_block_map);
+        p_memory->p_block_map = NULL;
+        free(p_memory->pp_pointer_index);
+        p_memory->pp_pointer_index = NULL;
+        free(p_memory->p_shadow);
+        p_memory->p_shadow = NULL;
+    } else if (p_memory->backing != STACK_BACKED) { // Reserved with mmap, unmapped with the same sizes main reserved
+        release_pages(p_memory->blocks.p_sizes, block_table_storage_size(p_memory->block_capacity));
+        p_memory->blocks.p_sizes = NULL;
+        release_pages(p_memory->p_bytes, p_memory->memory_size);
+        p_memory->p_bytes = NULL;
+        release_pages(p_memory->p_block_map, (p_memory->memory_size + BLOCK_MAP_PAGE_SIZE - 1) / BLOCK_MAP_PAGE_SIZE * sizeof(BlockId));
+        p_memory->p_block_map = NULL;
+        release_pages(p_memory->pp_pointer_index, (p_memory->memory_size + POINTER_INDEX_PAGE_SIZE - 1) / POINTER_INDEX_PAGE_SIZE * sizeof(Pointer*));
+        p_memory->pp_pointer_index = NULL;
+        release_pages(p_memory->p_shadow, shadow_storage_size(p_memory->memory_size));
+        p_memory->p_shadow = NULL;
     }
 
     exit_program("Bytethon."); // Nice closing animation function from utils.h.
@@ -0,0 +1,131 @@
+#include "compact.h"
+
+// Arguments parser for the compact function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function compact if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status compact_command(Memory *p_memory, int args_c, char *args[10]) {
+    (void)args; // compact takes no arguments
+    if (args_c != 0) {
+        print_error("Wrong amount of arguments for function compact. Expected 0 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = compact(p_memory);
+    if (success) {
+        print_success("Compacted the memory successfully, there are %zu blocks now.", p_memory->amount_of_blocks);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Moves every pointer in memory->p_pointers to where its block will start after compaction
+//
+// Input : A pointer to the memory and the new start index of every allocated block (by its id)
+//
+// Output : Every pointer keeps its offset inside its block (pointers into a region are somewhere inside the region's block)
+void relocate_pointers(Memory *p_memory, size_t *p_new_starts) {
+    HashMap *p_pointers = p_memory->p_pointers; // Readability
+    size_t *p_start_indices = p_memory->blocks.p_start_indices;
+
+    for (size_t i = 0; i < p_pointers->bucket_size; i++) {
+        for (HashNode *p_node = p_pointers->pp_map[i]; p_node != NULL; p_node = p_node->p_next) {
+            Pointer *p_ptr = (Pointer*)p_node->p_value;
+            if (p_ptr->start_index < 0) continue; // Not allocated yet
+
+            // Has to run before the blocks move, find_block uses the block map of the old start indices
+            BlockId block = (p_ptr->p_region != NULL) ? p_ptr->p_region->block : find_block(p_memory, (size_t)p_ptr->start_index);
+            if (block == NO_BLOCK) continue; // Doesn't point at a block, so there is nothing to move it with
+
+            p_ptr->start_index = (int64_t)(p_new_starts[block] + ((size_t)p_ptr->start_index - p_start_indices[block]));
+            pointer_index_update(p_memory, p_ptr);
+        }
+    }
+}
+
+// Slides every allocated block towards index 0 so all the free bytes become one block at the end of the memory.
+// Pointers are indexes into the bytes array, so every pointer in memory->p_pointers is moved along with its block
+//
+// Input : A pointer to the memory
+//
+// Output : The allocated blocks (and their bytes) are next to each other from index 0, followed by one free block with all the free bytes,
+// returns a boolean (0 or 1) if it succeded or not
+uint8_t compact(Memory *p_memory) {
+    if (!arr_allocators[p_memory->allocator].can_compact) {
+        print_error("The %s allocator can't compact the memory, its blocks have to stay where they are.", arr_allocators[p_memory->allocator].p_name);
+        return 0;
+    }
+
+    BlockTable *p_table = &p_memory->blocks; // Readability
+
+    // First pass, where every allocated block goes (only the ids that were ever used can be in the list)
+    size_t *p_new_starts = malloc(p_memory->amount_of_used_slots * sizeof(size_t));
+    if (!p_new_starts) {
+        fprintf(stderr, "Memory allocation failed for the new start indices!\n");
+        exit(1);
+    }
+    size_t end_of_used = 0;
+    for (BlockId curr = p_memory->first_block; curr != NO_BLOCK; curr = p_table->p_next[curr]) {
+        if (p_table->p_states[curr] & BLOCK_FREE) continue;
+        p_new_starts[curr] = end_of_used;
+        end_of_used += p_table->p_sizes[curr];
+    }
+    relocate_pointers(p_memory, p_new_starts);
+
+    size_t block_map_size = (p_memory->memory_size + BLOCK_MAP_PAGE_SIZE - 1) / BLOCK_MAP_PAGE_SIZE; // Same as in main
+    memset(p_memory->p_block_map, 0, block_map_size * sizeof(BlockId)); // Every page is empty, rebuilt from the new start indices below
+
+    // Second pass, move the allocated blocks and drop the free ones. Blocks only move left, 
+    // and in order of their start index, so memmove never writes over bytes that were not moved yet
+    BlockId last = NO_BLOCK; // The last allocated block that was kept
+    BlockId curr = p_memory->first_block;
+    while (curr != NO_BLOCK) {
+        BlockId next = p_table->p_next[curr]; // Releasing the slot writes over p_next
+
+        if (p_table->p_states[curr] & BLOCK_FREE) {
+            free_bins_remove(p_memory, curr); // Before the slot is reused
+            release_block_slot(p_memory, curr);
+        } else {
+            if (p_table->p_start_indices[curr] != p_new_starts[curr]) {
+                memmove(p_memory->p_bytes + p_new_starts[curr], p_memory->p_bytes + p_table->p_start_indices[curr], p_table->p_sizes[curr]);
+                shadow_copy(p_memory->p_shadow, p_new_starts[curr], p_memory->p_shadow, p_table->p_start_indices[curr], p_table->p_sizes[curr]);
+                watch_move(p_memory, p_table->p_start_indices[curr], p_new_starts[curr], p_table->p_sizes[curr]); // Blocks only move left, so a moved watchpoint is never moved twice
+                p_table->p_start_indices[curr] = p_new_starts[curr];
+            }
+
+            p_table->p_prev[curr] = last;
+            if (last != NO_BLOCK) {
+                p_table->p_next[last] = curr;
+            } else {
+                p_memory->first_block = curr;
+            }
+            block_map_insert(p_memory, curr);
+            last = curr;
+        }
+        curr = next;
+    }
+    free(p_new_starts);
+
+    // All the free bytes become one block after the last allocated block
+    if (end_of_used < p_memory->memory_size) {
+        BlockId free_block = take_block_slot(p_memory); // Can't fail, there was at least one free block whose slot was released
+        p_table->p_sizes[free_block] = p_memory->memory_size - end_of_used;
+        p_table->p_start_indices[free_block] = end_of_used;
+        p_table->p_states[free_block] = BLOCK_FREE;
+        shadow_clear(p_memory->p_shadow, end_of_used, p_memory->memory_size - end_of_used); // The bits of the blocks that moved away
+        p_table->p_prev[free_block] = last;
+        p_table->p_next[free_block] = NO_BLOCK;
+        if (last != NO_BLOCK) {
+            p_table->p_next[last] = free_block;
+        } else { // Nothing is allocated
+            p_memory->first_block = free_block;
+        }
+        block_map_insert(p_memory, free_block);
+        free_bins_insert(p_memory, free_block);
+    } else {
+        p_table->p_next[last] = NO_BLOCK;
+    }
+
+    p_memory->next_fit_rover = NO_BLOCK; // The block it pointed at might be gone
+    return 1;
+}
@@ -0,0 +1,136 @@
+#include "defrag.h"
+
+// Arguments parser for the set_defrag_budget function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function set_defrag_budget if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status defrag_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function defrag. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    long budget = strtol(args[0],&endptr,10); // Convert the string argument that user gave to a long based on decimal notation
+    if(*endptr != '\0' || budget < 0) { // Invalid input, 0 is allowed to turn it off
+        print_error("First argument in defrag must be a positive integer (no decimal point) or zero number <bytes>");
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = set_defrag_budget(p_memory, (size_t)budget);
+    if (success && budget == 0) {
+        print_success("Turned off the incremental defragmentation.");
+    } else if (success) {
+        print_success("The incremental defragmentation will move up to %ld bytes after every command.", budget);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Turns the incremental defragmentation on (or off), it moves at most <budget> bytes after every command
+//
+// Input : A pointer to the memory and how many bytes a step may move (0 turns it off)
+//
+// Output : Saves the budget in memory->defrag_budget, returns a boolean (0 or 1) if it succeded or not
+uint8_t set_defrag_budget(Memory *p_memory, size_t budget) {
+    if (!arr_allocators[p_memory->allocator].can_compact) { // Same as compact, the blocks can't move
+        print_error("The %s allocator can't defragment the memory, its blocks have to stay where they are.", arr_allocators[p_memory->allocator].p_name);
+        return 0;
+    }
+    p_memory->defrag_budget = budget;
+    return 1;
+}
+
+// One step of the incremental defragmentation, moves allocated blocks left over the first free block(s) 
+// from memory->defrag_position, until memory->defrag_budget bytes were moved
+//
+// Input : A pointer to the memory
+//
+// Output : The free block is pushed right past the moved blocks (and merged with the free blocks it reaches), 
+// the pointers of the moved blocks are moved with them, does nothing if the budget is 0
+void defrag_step(Memory *p_memory) {
+    if (p_memory->defrag_budget == 0) return; // Turned off
+    if (p_memory->journal.p_file != NULL) {
+        p_memory->journal.defrag_steps++; // The step moves blocks, so it is replayed before the next record
+    }
+    if (p_memory->defrag_position >= p_memory->memory_size) return; // Nothing left to defragment, until free_bins_insert lowers the position
+
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    size_t bytes_moved = 0;
+
+    // Blocks before defrag_position were defragmented by the last steps (if something was freed there since, free_bins_insert moved the position back to it)
+    BlockId free_block = find_block_containing(p_memory, p_memory->defrag_position);
+    while (free_block != NO_BLOCK && !(p_table->p_states[free_block] & BLOCK_FREE)) {
+        free_block = p_table->p_next[free_block];
+    }
+
+    while (free_block != NO_BLOCK) {
+        BlockId used_block = p_table->p_next[free_block]; // Free blocks next to each other are always merged, so this is allocated
+        if (used_block == NO_BLOCK) { // The free block is the last block, everything after defrag_position is defragmented
+            free_block = NO_BLOCK;
+            break;
+        }
+
+        if (p_table->p_sizes[used_block] > p_memory->defrag_budget) { // Can't move in any step, the gap before it is left for compact
+            free_block = p_table->p_next[used_block];
+            while (free_block != NO_BLOCK && !(p_table->p_states[free_block] & BLOCK_FREE)) {
+                free_block = p_table->p_next[free_block];
+            }
+            continue;
+        }
+        if (bytes_moved + p_table->p_sizes[used_block] > p_memory->defrag_budget) break; // The next step continues from this free block
+        bytes_moved += p_table->p_sizes[used_block];
+
+        swap_with_next_block(p_memory, free_block);
+        BlockId next = p_table->p_next[free_block];
+        if (next != NO_BLOCK && (p_table->p_states[next] & BLOCK_FREE)) { // Reached the next free block, take its bytes along
+            merge_block_right(p_memory, free_block);
+        }
+    }
+
+    // When the end was reached there are no gaps left, the next steps return right away instead of walking all the blocks again
+    p_memory->defrag_position = (free_block != NO_BLOCK) ? p_table->p_start_indices[free_block] : p_memory->memory_size;
+}
+
+// Swaps a free block with the allocated block after it, the bytes of the allocated block move to the start of the free block
+//
+// Input : A pointer to the memory and the id of a free block that has an allocated block after it
+//
+// Output : The allocated block (and the pointers into it) starts where the free block started, and the free block starts right after it
+void swap_with_next_block(Memory *p_memory, BlockId free_block) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    BlockId used_block = p_table->p_next[free_block];
+    BlockId prev = p_table->p_prev[free_block];
+    BlockId next = p_table->p_next[used_block];
+    size_t start = p_table->p_start_indices[free_block];
+
+    // Out of the block map while they are still linked in the old order, the free block first since the page might move on to the used block
+    block_map_remove(p_memory, free_block);
+    block_map_remove(p_memory, used_block);
+
+    // The free block is before the used block, so memmove copies from the start without writing over bytes it didn't copy yet
+    memmove(p_memory->p_bytes + start, p_memory->p_bytes + p_table->p_start_indices[used_block], p_table->p_sizes[used_block]);
+    shadow_copy(p_memory->p_shadow, start, p_memory->p_shadow, p_table->p_start_indices[used_block], p_table->p_sizes[used_block]);
+    watch_move(p_memory, p_table->p_start_indices[used_block], start, p_table->p_sizes[used_block]);
+    pointer_index_move(p_memory, p_table->p_start_indices[used_block], start, p_table->p_sizes[used_block]); // Only the pointers into the moved block are checked
+    p_table->p_start_indices[used_block] = start;
+    p_table->p_start_indices[free_block] = start + p_table->p_sizes[used_block];
+    shadow_clear(p_memory->p_shadow, p_table->p_start_indices[free_block], p_table->p_sizes[free_block]); // Free bytes hold garbage
+
+    // prev <-> used_block <-> free_block <-> next
+    p_table->p_prev[used_block] = prev;
+    p_table->p_next[used_block] = free_block;
+    p_table->p_prev[free_block] = used_block;
+    p_table->p_next[free_block] = next;
+    if (prev != NO_BLOCK) {
+        p_table->p_next[prev] = used_block;
+    } else {
+        p_memory->first_block = used_block;
+    }
+    if (next != NO_BLOCK) {
+        p_table->p_prev[next] = free_block;
+    }
+
+    block_map_insert(p_memory, used_block);
+    block_map_insert(p_memory, free_block);
+}
@@ -0,0 +1,359 @@
+#include "forks.h"
+
+#ifdef __linux__
+#include <unistd.h> // For fork(), pipe(), read() and write()
+#include <signal.h> // For kill() and ignoring SIGCHLD
+#include <poll.h> // For waiting on the pipe and on the process that runs the commands at once
+#include <errno.h>
+#include <sys/syscall.h> // For pidfd_open(), which glibc only wraps since 2.36
+#include <sys/mman.h> // For the shared registry
+#include <stdio_ext.h> // For __fpurge()
+#endif
+
+// Arguments parser for the fork_memory function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function fork_memory if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status fork_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function fork. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+    if (strlen(args[0]) >= FORK_NAME_SIZE) {
+        print_error("The name of a fork can be at most %d characters <name>", FORK_NAME_SIZE - 1);
+        return COMMAND_FAILED;
+    }
+
+    uint32_t slot = p_memory->fork_slot;
+    uint8_t success = fork_memory(p_memory, args[0]);
+    if (success && p_memory->fork_slot == slot) { // The new fork returns only when it is switched to, and the switch already printed
+        print_success("Forked the memory as %s successfully, use switch %s to continue from here.", args[0], args[0]);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Arguments parser for the switch_memory function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function switch_memory if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status switch_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function switch. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    uint32_t slot = find_fork(p_memory, args[0]);
+    if (slot == FORK_MAX_AMOUNT) {
+        print_error("Could not locate fork %s. Please create it with the command fork.", args[0]);
+        return COMMAND_FAILED;
+    }
+    if (slot == p_memory->fork_slot) {
+        print_error("Fork %s is the one in use already.", args[0]);
+        return COMMAND_FAILED;
+    }
+
+    print_success("Switched to fork %s successfully.", args[0]); // Before the switch, the other process prints the next output
+    switch_memory(p_memory, slot);
+    return COMMAND_SUCCEEDED;
+}
+
+// Arguments parser for the drop_memory function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function drop_memory if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status drop_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function drop. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    uint32_t slot = find_fork(p_memory, args[0]);
+    if (slot == FORK_MAX_AMOUNT) {
+        print_error("Could not locate fork %s. Please create it with the command fork.", args[0]);
+        return COMMAND_FAILED;
+    }
+    if (slot == p_memory->fork_slot) {
+        print_error("Fork %s is the one in use, switch to another fork before dropping it.", args[0]);
+        return COMMAND_FAILED;
+    }
+
+    drop_memory(p_memory, slot);
+    print_success("Dropped fork %s successfully.", args[0]);
+    return COMMAND_SUCCEEDED;
+}
+
+// Makes a copy-on-write copy of the whole memory (bytes, block table, pointers and regions) that can be switched to later, by forking the process (Linux only).
+// The kernel only copies a page when one of the forks writes to it, so a fork costs as much memory as what changes after it
+//
+// Input : A pointer to the memory and the name of the new fork
+//
+// Output : Returns 1 in this process, which keeps running the commands, and the new process waits until it is switched to
+// (then it returns 1 as well, with memory->fork_slot set to its own slot). Returns 0 (after printing an error) if it couldn't fork
+uint8_t fork_memory(Memory *p_memory, const char *name) {
+#ifdef __linux__
+    if (p_memory->p_forks == NULL && !init_fork_registry(p_memory)) {
+        return 0;
+    }
+    if (find_fork(p_memory, name) != FORK_MAX_AMOUNT) {
+        print_error("A fork with the name %s already exists.", name);
+        return 0;
+    }
+
+    Fork_Registry *p_forks = p_memory->p_forks; // Readability
+    uint32_t slot = 0;
+    while (slot < FORK_MAX_AMOUNT && p_forks->arr_slots[slot].arr_name[0] != '\0') {
+        slot++;
+    }
+    if (slot == FORK_MAX_AMOUNT) {
+        print_error("There are %d forks already, drop one before forking again.", FORK_MAX_AMOUNT);
+        return 0;
+    }
+    strcpy(p_forks->arr_slots[slot].arr_name, name);
+
+    // Both processes have the same stdout buffer after fork, if it is not empty both of them print it
+    fflush(stdout);
+    fflush(stderr);
+    pid_t pid = fork();
+    if (pid < 0) {
+        p_forks->arr_slots[slot].arr_name[0] = '\0';
+        print_error("Could not fork the process.");
+        return 0;
+    }
+    if (pid == 0) { // The new fork, it has the memory as it is now until it is switched to
+        p_memory->fork_slot = slot;
+        journal_detach(p_memory); // The journal is of the memory that started it
+        wait_for_turn(p_memory);
+        return 1;
+    }
+    p_forks->arr_slots[slot].pid = (int32_t)pid;
+    return 1;
+#else
+    (void)p_memory;
+    (void)name;
+    print_error("Forks copy the process with fork(), which is only available on Linux.");
+    return 0;
+#endif
+}
+
+// Lets another fork run the next commands, and waits until a fork switches back to this one
+//
+// Input : A pointer to the memory and the slot of the fork to switch to
+//
+// Output : Returns when this fork is switched to again (the memory is as it was when it switched away)
+void switch_memory(Memory *p_memory, uint32_t slot) {
+#ifdef __linux__
+    Fork_Registry *p_forks = p_memory->p_forks; // Readability
+    p_forks->active_pid = p_forks->arr_slots[slot].pid;
+    fflush(stdout); // Everything this fork printed comes before what the other one prints
+
+    char turn = FORK_TURN;
+    if (write(p_forks->arr_slots[slot].arr_turn_pipe[1], &turn, 1) != 1) {
+        p_forks->active_pid = (int32_t)getpid();
+        print_error("Could not wake fork %s.", p_forks->arr_slots[slot].arr_name);
+        return;
+    }
+    // The other waiting forks watch this process, they have to watch the new one to exit if it is gone
+    turn = FORK_NEW_ACTIVE;
+    for (uint32_t other = 0; other < FORK_MAX_AMOUNT; other++) {
+        if (other != slot && other != p_memory->fork_slot && p_forks->arr_slots[other].arr_name[0] != '\0') {
+            if (write(p_forks->arr_slots[other].arr_turn_pipe[1], &turn, 1) != 1) {
+                print_error("Could not tell fork %s that fork %s is used now.", p_forks->arr_slots[other].arr_name, p_forks->arr_slots[slot].arr_name);
+            }
+        }
+    }
+    wait_for_turn(p_memory);
+#else
+    (void)p_memory;
+    (void)slot;
+#endif
+}
+
+// Deletes a fork that is not the one running, so the pages only it had are given back to the system
+//
+// Input : A pointer to the memory and the slot of the fork
+//
+// Output : Kills the process of the fork and frees its slot
+void drop_memory(Memory *p_memory, uint32_t slot) {
+#ifdef __linux__
+    Fork_Slot *p_slot = &p_memory->p_forks->arr_slots[slot]; // Readability
+    kill(p_slot->pid, SIGKILL); // It is waiting for its turn, so it has nothing to clean up (SIGCHLD is ignored, so it doesn't stay a zombie)
+    p_slot->pid = 0;
+    p_slot->arr_name[0] = '\0';
+#else
+    (void)p_memory;
+    (void)slot;
+#endif
+}
+
+// Kills the processes of every other fork, called before the program exits
+//
+// Input : A pointer to the memory
+//
+// Output : Every fork but this one is dropped, and the shared registry is unmapped
+void drop_all_forks(Memory *p_memory) {
+#ifdef __linux__
+    if (p_memory->p_forks == NULL) {
+        return;
+    }
+    for (uint32_t slot = 0; slot < FORK_MAX_AMOUNT; slot++) {
+        if (slot != p_memory->fork_slot && p_memory->p_forks->arr_slots[slot].arr_name[0] != '\0') {
+            drop_memory(p_memory, slot);
+        }
+    }
+    munmap(p_memory->p_forks, sizeof(Fork_Registry));
+    p_memory->p_forks = NULL;
+#else
+    (void)p_memory;
+#endif
+}
+
+// Creates the registry of the forks the first time the fork command is used
+//
+// Input : A pointer to the memory
+//
+// Output : Maps the registry (shared between processes), creates a pipe for every slot, shares stdin (see share_stdin) and puts the current memory in slot 0 as "main",
+// returns a boolean (0 or 1) if it succeded or not
+uint8_t init_fork_registry(Memory *p_memory) {
+#ifdef __linux__
+    // MAP_SHARED, so a fork that is created or dropped by one process is seen by all of them
+    Fork_Registry *p_forks = mmap(NULL, sizeof(Fork_Registry), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (p_forks == MAP_FAILED) {
+        print_error("Could not map the registry of the forks.");
+        return 0;
+    }
+    memset(p_forks, 0, sizeof(Fork_Registry));
+
+    // Every pipe is made before the first fork, so every process has all of them (a fork made later can still be woken by all the others)
+    for (uint32_t slot = 0; slot < FORK_MAX_AMOUNT; slot++) {
+        if (pipe(p_forks->arr_slots[slot].arr_turn_pipe) != 0) {
+            print_error("Could not create the pipes of the forks.");
+            munmap(p_forks, sizeof(Fork_Registry));
+            return 0;
+        }
+    }
+    signal(SIGCHLD, SIG_IGN); // Dropped forks are cleaned up by the system, no one waits for them
+    if (!share_stdin()) {
+        munmap(p_forks, sizeof(Fork_Registry));
+        return 0;
+    }
+
+    strcpy(p_forks->arr_slots[0].arr_name, "main");
+    p_forks->arr_slots[0].pid = (int32_t)getpid();
+    p_forks->active_pid = (int32_t)getpid();
+    p_memory->p_forks = p_forks;
+    p_memory->fork_slot = 0;
+    return 1;
+#else
+    (void)p_memory;
+    return 0;
+#endif
+}
+
+// Makes stdin unbuffered before the first fork, because the forks read the commands from the same stdin and none of them may read ahead of the commands it runs
+//
+// Input : None
+//
+// Output : A file goes back to the first command that wasn't run and a terminal gives one line at a time, so both only become unbuffered.
+// The commands that were read ahead from a pipe can't be put back, so a process copies them and the rest of the pipe to a new pipe that becomes stdin.
+// Returns a boolean (0 or 1) if it succeded or not
+uint8_t share_stdin(void) {
+#ifdef __linux__
+    if (isatty(STDIN_FILENO) || lseek(STDIN_FILENO, 0, SEEK_CUR) != -1) {
+        fflush(stdin); // Moves a file back to the first byte that wasn't read
+        setvbuf(stdin, NULL, _IONBF, 0);
+        return 1;
+    }
+
+    int arr_stdin_pipe[2];
+    if (pipe(arr_stdin_pipe) != 0) {
+        print_error("Could not create the pipe of stdin.");
+        return 0;
+    }
+    fflush(stdout); // Else the copying process has the same stdout buffer (it exits without printing it, but to be sure)
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(arr_stdin_pipe[0]);
+        close(arr_stdin_pipe[1]);
+        print_error("Could not fork the process that copies stdin.");
+        return 0;
+    }
+    if (pid == 0) { // Has the same stdin buffer, so it copies the commands that were read ahead first
+        close(arr_stdin_pipe[0]);
+        char line[256];
+        while (fgets(line, sizeof(line), stdin) != NULL) {
+            size_t length = strlen(line);
+            if (write(arr_stdin_pipe[1], line, length) != (ssize_t)length) { // Every fork is gone
+                break;
+            }
+        }
+        _exit(0); // Without the atexit and stdio cleanup of the memory it is a copy of
+    }
+    dup2(arr_stdin_pipe[0], STDIN_FILENO);
+    close(arr_stdin_pipe[0]);
+    close(arr_stdin_pipe[1]); // So the forks see the end of the input when the copying process exits
+    __fpurge(stdin); // The copying process has what was read ahead
+    setvbuf(stdin, NULL, _IONBF, 0);
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+// Finds the slot of a fork by its name
+//
+// Input : A pointer to the memory and the name of the fork
+//
+// Output : Returns the index of the slot, or FORK_MAX_AMOUNT if there is no fork with that name (or no forks at all)
+uint32_t find_fork(Memory *p_memory, const char *name) {
+    if (p_memory->p_forks == NULL) {
+        return FORK_MAX_AMOUNT;
+    }
+    for (uint32_t slot = 0; slot < FORK_MAX_AMOUNT; slot++) {
+        if (same_string(p_memory->p_forks->arr_slots[slot].arr_name, name)) {
+            return slot;
+        }
+    }
+    return FORK_MAX_AMOUNT;
+}
+
+// Waits until another fork switches to the fork of this process
+//
+// Input : A pointer to the memory
+//
+// Output : Returns when FORK_TURN is written to the pipe of memory->fork_slot, exits as soon as the process that runs the commands is gone
+void wait_for_turn(Memory *p_memory) {
+#ifdef __linux__
+    Fork_Registry *p_forks = p_memory->p_forks; // Readability
+    // [0] is the pipe of this fork, [1] is readable when the process that runs the commands exits
+    struct pollfd arr_waits[2] = {
+        {.fd = p_forks->arr_slots[p_memory->fork_slot].arr_turn_pipe[0], .events = POLLIN},
+        {.fd = -1, .events = POLLIN}
+    };
+    while (1) {
+        arr_waits[1].fd = (int)syscall(SYS_pidfd_open, (pid_t)p_forks->active_pid, 0);
+        if (arr_waits[1].fd < 0 && errno == ESRCH) { // Nothing will switch to this fork anymore
+            exit(0);
+        }
+        int ready = poll(arr_waits, 2, -1); // poll skips a negative fd, so before Linux 5.3 (no pidfd_open) it only waits on the pipe
+        if (arr_waits[1].fd >= 0) {
+            close(arr_waits[1].fd);
+        }
+        if (ready <= 0) { // Interrupted by a signal
+            continue;
+        }
+        if (arr_waits[0].revents & POLLIN) {
+            char turn;
+            if (read(arr_waits[0].fd, &turn, 1) == 1 && turn == FORK_TURN) {
+                return;
+            }
+        } else if (arr_waits[1].revents & POLLIN) {
+            exit(0);
+        }
+    }
+#else
+    (void)p_memory;
+#endif
+}
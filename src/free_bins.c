@@ -0,0 +1,117 @@
+#include "free_bins.h"
+
+// Gets the size class bin that a free block of <size> bytes belongs to
+//
+// Input : A size in bytes (must be more than 0)
+//
+// Output : Returns floor(log2(size)), so bin k holds the sizes 2^k to 2^(k+1) - 1
+unsigned int size_class(size_t size) {
+    return (unsigned int)(63 - __builtin_clzll((unsigned long long)size)); // Index of the highest bit that is on
+}
+
+// Adds a free block to the head of the bin for its size class and turns on the bin's bit in the bitmap
+//
+// Input : A pointer to the memory and the id of a free block
+//
+// Output : The block is linked into memory->arr_free_bins (or the TLSF lists), does nothing if the allocator doesn't keep bins.
+// memory->defrag_position moves back to the block if it is before it, so the defragmentation looks at the new gap
+void free_bins_insert(Memory *p_memory, BlockId block) {
+    // Every new free block passes through here, with or without bins
+    if (p_memory->blocks.p_start_indices[block] < p_memory->defrag_position) {
+        p_memory->defrag_position = p_memory->blocks.p_start_indices[block];
+    }
+    if (!arr_allocators[p_memory->allocator].keeps_bins) return; // Allocators that scan the list don't keep bins
+    if (p_memory->allocator == TLSF) { // TLSF has two levels of bins
+        tlsf_insert(p_memory, block);
+        return;
+    }
+
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    unsigned int bin = size_class(p_table->p_sizes[block]);
+    BlockId old_head = p_memory->arr_free_bins[bin];
+
+    // Push to the head of the bin, so the most recently freed block is reused first
+    p_table->p_prev_free[block] = NO_BLOCK;
+    p_table->p_next_free[block] = old_head;
+    if (old_head != NO_BLOCK) {
+        p_table->p_prev_free[old_head] = block;
+    }
+    p_memory->arr_free_bins[bin] = block;
+
+    p_memory->free_bins_bitmap |= (uint64_t)1 << bin; // The bin is not empty anymore
+}
+
+// Removes a free block from the bin for its size class, and turns off the bin's bit if the bin became empty
+// Must be called before the size of the block changes, otherwise the wrong bin is searched
+//
+// Input : A pointer to the memory and the id of a free block that is in one of the bins
+//
+// Output : The block is unlinked from memory->arr_free_bins (or the TLSF lists), does nothing if the allocator doesn't keep bins
+void free_bins_remove(Memory *p_memory, BlockId block) {
+    if (!arr_allocators[p_memory->allocator].keeps_bins) return; // Allocators that scan the list don't keep bins
+    if (p_memory->allocator == TLSF) { // TLSF has two levels of bins
+        tlsf_remove(p_memory, block);
+        return;
+    }
+
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    unsigned int bin = size_class(p_table->p_sizes[block]);
+    BlockId prev = p_table->p_prev_free[block];
+    BlockId next = p_table->p_next_free[block];
+
+    if (prev != NO_BLOCK) {
+        p_table->p_next_free[prev] = next;
+    } else { // The block is the head of the bin
+        p_memory->arr_free_bins[bin] = next;
+    }
+    if (next != NO_BLOCK) {
+        p_table->p_prev_free[next] = prev;
+    }
+    p_table->p_next_free[block] = NO_BLOCK;
+    p_table->p_prev_free[block] = NO_BLOCK;
+
+    if (p_memory->arr_free_bins[bin] == NO_BLOCK) {
+        p_memory->free_bins_bitmap &= ~((uint64_t)1 << bin); // Last block of the bin was removed
+    }
+}
+
+// Finds a free block that fits <size> bytes well, by only looking at bins that can hold a block that big,
+// and at most FREE_BINS_MAX_CANDIDATES blocks of a bin
+//
+// Input : A pointer to the memory and the size of the allocation
+//
+// Output : Returns the id of the best fitting free block of the ones it looked at, or NO_BLOCK if no free block is big enough
+BlockId free_bins_find(Memory *p_memory, size_t size) {
+    size_t *p_sizes = p_memory->blocks.p_sizes; // Readability
+    BlockId *p_next_free = p_memory->blocks.p_next_free;
+    unsigned int bin = size_class(size);
+    BlockId best = NO_BLOCK;
+
+    // The bin of the size itself also holds blocks that are smaller than size, so check the first candidates of it
+    BlockId curr = p_memory->arr_free_bins[bin];
+    for (int i = 0; curr != NO_BLOCK && i < FREE_BINS_MAX_CANDIDATES; curr = p_next_free[curr], i++) {
+        if (p_sizes[curr] == size) return curr; // Perfect fit, can't do better
+        if (p_sizes[curr] > size && (best == NO_BLOCK || p_sizes[curr] < p_sizes[best])) {
+            best = curr;
+        }
+    }
+    if (best != NO_BLOCK) return best; // Anything in a higher bin is bigger than every block in this bin
+
+    uint64_t bigger_bins = (bin + 1 < AMOUNT_OF_SIZE_CLASSES) ? p_memory->free_bins_bitmap & ~(((uint64_t)2 << bin) - 1) : 0; // Only the non empty bins above <bin>
+    if (!bigger_bins) { // The rest of this bin is the only place left, the first block that fits is taken so malloc doesn't fail while one does
+        for (; curr != NO_BLOCK; curr = p_next_free[curr]) {
+            if (p_sizes[curr] >= size) return curr;
+        }
+        return NO_BLOCK; // No free block is big enough
+    }
+
+    // Every block in the lowest non empty bin fits, take the smallest of its first candidates
+    unsigned int lowest_bin = (unsigned int)__builtin_ctzll(bigger_bins);
+    curr = p_memory->arr_free_bins[lowest_bin];
+    for (int i = 0; curr != NO_BLOCK && i < FREE_BINS_MAX_CANDIDATES; curr = p_next_free[curr], i++) {
+        if (best == NO_BLOCK || p_sizes[curr] < p_sizes[best]) {
+            best = curr;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,190 @@
+#include "gc.h"
+
+// Arguments parser for the collect_garbage function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function collect_garbage if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status gc_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function gc. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    long mode = strtol(args[0],&endptr,10); // Convert the string argument that user gave to a long based on decimal notation
+    if(*endptr != '\0' || (mode != GC_POINTERS && mode != GC_CONSERVATIVE)) { // Invalid input
+        print_error("First argument in gc must be %d (only pointers are roots) or %d (also scan the bytes of blocks) <mode>", GC_POINTERS, GC_CONSERVATIVE);
+        return COMMAND_FAILED;
+    }
+
+    size_t freed_bytes;
+    size_t freed_blocks = collect_garbage(p_memory, (Gc_Mode)mode, &freed_bytes);
+    print_success("Collected %zu unreachable blocks (%zu bytes) successfully.", freed_blocks, freed_bytes);
+    return COMMAND_SUCCEEDED;
+}
+
+// Arguments parser for the gc_auto command, which sets how my_malloc() collects garbage when it can't find a free block
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Sets memory->gc_auto if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status gc_auto_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function gc_auto. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    long mode = strtol(args[0],&endptr,10);
+    if(*endptr != '\0' || mode < GC_OFF || mode > GC_CONSERVATIVE) { // Invalid input
+        print_error("First argument in gc_auto must be %d (off), %d (only pointers are roots) or %d (also scan the bytes of blocks) <mode>", 
+            GC_OFF, GC_POINTERS, GC_CONSERVATIVE);
+        return COMMAND_FAILED;
+    }
+
+    p_memory->gc_auto = (Gc_Mode)mode;
+    if (mode == GC_OFF) {
+        print_success("Garbage will only be collected by the gc command.");
+    } else {
+        print_success("Garbage will be collected (mode %ld) when malloc can't find a free block.", mode);
+    }
+    return COMMAND_SUCCEEDED;
+}
+
+// Frees every allocated block that can't be reached (mark and sweep). The roots are the pointers in memory->p_pointers and the blocks of the regions,
+// and with GC_CONSERVATIVE, the bytes of every reachable block are scanned for numbers that are the start of a block as well
+//
+// Input : A pointer to the memory, how to find references (GC_POINTERS or GC_CONSERVATIVE), and where to put how many bytes were freed
+//
+// Output : Returns how many blocks were freed, the free blocks are merged in the same sweep
+size_t collect_garbage(Memory *p_memory, Gc_Mode mode, size_t *p_freed_bytes) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    size_t amount_of_slots = p_memory->amount_of_used_slots; // Only these ids can be in the linked list
+
+    // The marks are one bit per block id next to each other, instead of a bit in p_states that is 1 byte per block
+    uint64_t *p_marks = calloc((amount_of_slots + 63) / 64, sizeof(uint64_t));
+    BlockId *p_stack = malloc(amount_of_slots * sizeof(BlockId)); // Every block is pushed at most once
+    if (!p_marks || !p_stack) {
+        fprintf(stderr, "Memory allocation failed for the garbage collector!\n");
+        exit(1);
+    }
+    size_t stack_size = 0;
+
+    // Mark the roots
+    HashMap *p_pointers = p_memory->p_pointers;
+    for (size_t i = 0; i < p_pointers->bucket_size; i++) {
+        for (HashNode *p_node = p_pointers->pp_map[i]; p_node != NULL; p_node = p_node->p_next) {
+            Pointer *p_ptr = (Pointer*)p_node->p_value;
+            if (p_ptr->p_region != NULL || p_ptr->start_index < 0) continue; // The regions are roots by themselves
+            BlockId block = find_block(p_memory, (size_t)p_ptr->start_index);
+            if (block != NO_BLOCK && gc_mark(p_marks, block)) {
+                p_stack[stack_size++] = block;
+            }
+        }
+    }
+    HashMap *p_regions = p_memory->p_regions;
+    for (size_t i = 0; i < p_regions->bucket_size; i++) {
+        for (HashNode *p_node = p_regions->pp_map[i]; p_node != NULL; p_node = p_node->p_next) {
+            BlockId block = ((Region*)p_node->p_value)->block;
+            if (gc_mark(p_marks, block)) {
+                p_stack[stack_size++] = block;
+            }
+        }
+    }
+
+    // Mark everything the reachable blocks might point at
+    if (mode == GC_CONSERVATIVE) {
+        while (stack_size > 0) {
+            gc_scan_block(p_memory, p_marks, p_stack[--stack_size], p_stack, &stack_size);
+        }
+    }
+
+    // Sweep, free the blocks that were not marked and merge every free block into the free block before it
+    void (*p_free)(Memory*, BlockId) = arr_allocators[p_memory->allocator].p_free; // Buddy blocks only merge with their buddy
+    size_t freed_blocks = 0;
+    *p_freed_bytes = 0;
+    stack_size = 0; // Reused for the blocks that p_free frees after the sweep
+    BlockId prev = NO_BLOCK;
+    BlockId curr = p_memory->first_block;
+    while (curr != NO_BLOCK) {
+        BlockId next = p_table->p_next[curr]; // Merging releases the slot of curr
+        uint8_t marked = (p_marks[curr / 64] >> (curr % 64)) & 1;
+
+        if (!(p_table->p_states[curr] & BLOCK_FREE) && !marked) {
+            freed_blocks++;
+            *p_freed_bytes += p_table->p_sizes[curr];
+            if (p_free) { // Freed after the sweep, merging now could release the slot of next
+                p_stack[stack_size++] = curr;
+            } else {
+                p_table->p_states[curr] = BLOCK_FREE;
+                shadow_clear(p_memory->p_shadow, p_table->p_start_indices[curr], p_table->p_sizes[curr]);
+                watch_free(p_memory, p_table->p_start_indices[curr], p_table->p_sizes[curr]);
+                free_bins_insert(p_memory, curr);
+            }
+        }
+
+        if (!p_free && prev != NO_BLOCK && (p_table->p_states[prev] & BLOCK_FREE) && (p_table->p_states[curr] & BLOCK_FREE)) {
+            merge_block_right(p_memory, prev); // prev eats curr, and stays prev for the next block
+        } else {
+            prev = curr;
+        }
+        curr = next;
+    }
+    for (size_t i = 0; i < stack_size; i++) {
+        p_free(p_memory, p_stack[i]);
+    }
+
+    free(p_marks);
+    free(p_stack);
+    return freed_blocks;
+}
+
+// Marks a block as reachable in the side bitmap of the collector
+//
+// Input : The mark bitmap (one bit per block id) and the id of the block
+//
+// Output : Returns 1 if the block was not marked before (so it has to be scanned), or 0 if it was
+uint8_t gc_mark(uint64_t *p_marks, BlockId block) {
+    uint64_t bit = (uint64_t)1 << (block % 64);
+    if (p_marks[block / 64] & bit) {
+        return 0;
+    }
+    p_marks[block / 64] |= bit;
+    return 1;
+}
+
+// Reads the bytes of a reachable block as numbers in both byte orders, and marks the blocks that start at one of them (conservative, any number can be an index)
+//
+// Input : A pointer to the memory, the mark bitmap, the id of the block, and the stack of blocks to scan and its size
+//
+// Output : Every block that the bytes might point at is marked and pushed to the stack
+void gc_scan_block(Memory *p_memory, uint64_t *p_marks, BlockId block, BlockId *p_stack, size_t *p_stack_size) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    size_t start = p_table->p_start_indices[block];
+    size_t size = p_table->p_sizes[block];
+    if (shadow_count(p_memory->p_shadow, start, size) == 0) return; // Nothing was written in it, so it can't hold an index
+
+    size_t width = (size < GC_SCAN_WIDTH) ? size : GC_SCAN_WIDTH;
+    uint8_t *p_bytes = p_memory->p_bytes + start;
+
+    // The last <width> bytes as a number both ways: the last byte is the lowest (like set_val and store ..be write it) or the first one is (like store ..le)
+    uint64_t big_endian = 0, little_endian = 0;
+    for (size_t i = 0; i < size; i++) {
+        uint8_t written = (uint8_t)shadow_read_bits(p_memory->p_shadow, start + i, 1);
+        uint64_t byte = written ? p_bytes[i] : 0; // A garbage byte is read as 0, like set_val's leading zeros
+        big_endian = (big_endian << 8) | byte; // The byte that left the window is shifted out of the 64 bits
+        little_endian = (little_endian >> 8) | (byte << (8 * (width - 1)));
+        if (i + 1 < width) { // Not <width> bytes yet
+            continue;
+        }
+
+        uint64_t arr_values[2] = {big_endian, little_endian};
+        for (int order = 0; order < 2; order++) {
+            BlockId target = find_block(p_memory, (size_t)arr_values[order]); // NO_BLOCK if the number is not the start of an allocated block
+            if (target != NO_BLOCK && gc_mark(p_marks, target)) {
+                p_stack[(*p_stack_size)++] = target;
+            }
+        }
+    }
+}
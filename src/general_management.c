@@ -1,83 +1,148 @@
 #include "general_management.h"
 
-// Moves all items in the block array in the memory starting from an index one index left
+// Calculates how many bytes the arrays of a block table with <capacity> slots take together
 //
-// Input : A pointer to the memory, the starting index
+// Input : The amount of slots in the block table
 //
-// Output : Moves all items in the memory blocks array such that if index = 0, memory->blocks[0] = memory->blocks[1], memory->blocks[1] = memory->blocks[2]...
-// Ends up overwriting the index <index> in blocks array
-// Returns a boolean (0 or 1) based on failure/success
-uint8_t shift_left(Memory *p_memory, unsigned int index) {
-    if (index >=p_memory->memory_size) return 0; // If the index is out of bounds shift failed
+// Output : Returns the size in bytes of the storage that init_block_table needs for <capacity> slots
+size_t block_table_storage_size(size_t capacity) {
+    return capacity * BLOCK_METADATA_SIZE;
+}
+
+// Calculates how many slots the block table of a memory needs
+//
+// Input : The size of the memory in bytes
+//
+// Output : Returns one slot for every byte (there can't be more blocks than bytes), but less than NO_BLOCK so every slot has an id
+size_t block_table_capacity(size_t memory_size) {
+    return (memory_size < (size_t)NO_BLOCK) ? memory_size : (size_t)NO_BLOCK - 1;
+}
 
-    size_t num_blocks_to_move = (p_memory->amount_of_blocks - index - 1) ; // Calculate the size that needs to be moved in sizeof(Block)
+// Splits one buffer into the arrays of a block table (so the table can be on the stack or one malloc)
+//
+// Input : A pointer to the block table, a buffer of block_table_storage_size(capacity) bytes aligned for size_t, and the amount of slots
+//
+// Output : Points every array of the table into the buffer, the widest arrays first so they stay aligned
+void init_block_table(BlockTable *p_table, void *p_storage, size_t capacity) {
+    size_t *p_words = (size_t*)p_storage; // The sizes and starts are 64 bit so blocks can be anywhere in a memory bigger than 4 GB
 
-    Block *p_curr = &p_memory->p_blocks[index+1];
-    while (p_curr != NULL) { // Preupdate the pointers in the linked list
-        Block *next_block = p_curr->p_next;  // Store next block before modifying so you know which block to next update
-        
-        p_curr->p_prev = p_curr->p_prev ? p_curr->p_prev - 1 : NULL; // Move the pointer by 1
-        p_curr->p_next = p_curr->p_next ? p_curr->p_next - 1 : NULL; // Move the pointer by 1
+    // Hot fields next to each other, then the cold links
+    p_table->p_sizes = p_words;
+    p_table->p_start_indices = p_words + capacity;
+    BlockId *p_links = (BlockId*)(p_words + 2 * capacity); // The links stay 32 bit, there are less blocks than NO_BLOCK
+    p_table->p_next = p_links;
+    p_table->p_prev = p_links + capacity;
+    p_table->p_next_free = p_links + 2 * capacity;
+    p_table->p_prev_free = p_links + 3 * capacity;
+    p_table->p_states = (uint8_t*)(p_links + 4 * capacity); // Last, as 8 bit items don't keep the alignment for what comes after them
+}
 
-        p_curr = next_block;  // Move to the next block safely
+// Takes an unused slot from the block table for a new block
+//
+// Input : A pointer to the memory
+//
+// Output : Returns the id of an unused slot, reusing slots of blocks that were merged away first,
+// or NO_BLOCK if every slot of the block table is in use
+BlockId take_block_slot(Memory *p_memory) {
+    BlockId slot = p_memory->free_slots;
+    if (slot != NO_BLOCK) { // Reuse the slot of a block that was merged away
+        p_memory->free_slots = p_memory->blocks.p_next[slot];
+    } else if (p_memory->amount_of_used_slots < p_memory->block_capacity) { // Never used slots are handed out in order, so they don't need to be chained at startup
+        slot = (BlockId)p_memory->amount_of_used_slots++;
+    } else { // There can't be more blocks than bytes (or than ids)
+        return NO_BLOCK;
     }
 
-    memmove(&p_memory->p_blocks[index], &p_memory->p_blocks[index + 1], num_blocks_to_move * sizeof(Block)); // Move num_blocks_to_move (bytes) from the index + 1 to the index.
+    p_memory->amount_of_blocks++;
+    return slot;
+}
 
-    return 1;
+// Gives back the slot of a block that is no longer in the linked list, so a later split can reuse it
+//
+// Input : A pointer to the memory and the id of the block whose slot is not needed anymore
+//
+// Output : Pushes the slot to the head of the free slots list (chained through p_next)
+void release_block_slot(Memory *p_memory, BlockId block) {
+    p_memory->blocks.p_prev[block] = NO_BLOCK;
+    p_memory->blocks.p_next[block] = p_memory->free_slots;
+    p_memory->free_slots = block;
+
+    p_memory->amount_of_blocks--;
 }
 
-// Moves all items in the block array in the memory starting from an index one index right
+// Registers a block that starts at its start index in the block map, so find_block can locate it
 //
-// Input : A pointer to the memory, the starting index
+// Input : A pointer to the memory and the id of the new block
 //
-// Output : Moves all items in the memory blocks array such that if index = 0, memory->blocks[1] = memory->blocks[0], memory->blocks[2] = memory->blocks[1]...
-// Ends up overwriting the last index of the blocks array
-// Returns a boolean (0 or 1) based on failure/success
-uint8_t shift_right(Memory *p_memory, unsigned int index) {
-    if (index >=p_memory->memory_size) return 0; // If the index is out of bounds shift failed
+// Output : If the block is the first block that starts in its page of the bytes array, the page points at it
+void block_map_insert(Memory *p_memory, BlockId block) {
+    size_t *p_start_indices = p_memory->blocks.p_start_indices; // Readability
+    BlockId *p_page = &p_memory->p_block_map[p_start_indices[block] / BLOCK_MAP_PAGE_SIZE];
+    BlockId first = *p_page - 1; // The map holds ids plus 1, so 0 (an empty page) wraps around to NO_BLOCK
 
-    size_t num_blocks_to_move = (p_memory->amount_of_blocks - index); // Calculate the size that needs to be moved in sizeof(Block)
-    if (p_memory->amount_of_blocks >= p_memory->memory_size) { // If the next block's index outside the array
-        return 0;  // Prevent moving blocks past the array size
-    }
-    // Shift memory from the relevant index to the right
-    Block *p_curr = &p_memory->p_blocks[index];
-    while (p_curr != NULL) { // Premove the pointers
-        Block *next_block = p_curr->p_next;  // Store next block before modifying
-        
-        p_curr->p_prev = p_curr->p_prev ? p_curr->p_prev + 1 : NULL; // Move the pointer by 1 to point at the next 
-        p_curr->p_next = p_curr->p_next ? p_curr->p_next + 1 : NULL; // Move the pointer by 1
-
-        p_curr = next_block;  // Move to the next block safely
+    if (first == NO_BLOCK || p_start_indices[first] > p_start_indices[block]) { // Each page points at the lowest block that starts in it
+        *p_page = block + 1;
     }
-    memmove(&p_memory->p_blocks[index + 1], &p_memory->p_blocks[index], num_blocks_to_move * sizeof(Block)); // Move the amount of blocks from index+1 to index
+}
+
+// Unregisters a block from the block map before it is removed from the linked list
+//
+// Input : A pointer to the memory and the id of the block that is going away (still linked)
+//
+// Output : If the page pointed at the block, it now points at the next block in the same page (or is empty)
+void block_map_remove(Memory *p_memory, BlockId block) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    size_t page = p_table->p_start_indices[block] / BLOCK_MAP_PAGE_SIZE;
+    if (p_memory->p_block_map[page] - 1 != block) return; // A lower block in the page is the one the page points at
 
-    return 1;
+    BlockId next = p_table->p_next[block];
+    p_memory->p_block_map[page] = (next != NO_BLOCK && p_table->p_start_indices[next] / BLOCK_MAP_PAGE_SIZE == page) ? next + 1 : 0;
 }
 
-// Finds a block in the blocks array based on a corresponding index in the bytes array
+// Finds the allocated block in the block table that starts at an index in the bytes array (where a Pointer points)
 //
-// Input : A pointer to the memory, the lookup index, and a block double pointer to store a pointer for the block 
-//(**block is a pointer to a *block pointer which lets you acess the block the function found)
+// Input : A pointer to the memory and the lookup index
 //
-// Output : assigns the pointer that the double pointer block holds, to a pointer to the block found, 
-// and returns the index of the block in the blocks array as well (or -1 if not found)
-int find_block(Memory *p_memory, unsigned int index, Block **pp_block) { 
-    size_t sum = 0;
+// Output : Returns the id of the block found, or NO_BLOCK if no allocated block starts at the index
+BlockId find_block(Memory *p_memory, size_t index) { 
+    if (index >= p_memory->memory_size) return NO_BLOCK; // Outside of the bytes array
 
-    for (int i = 0; i < p_memory->amount_of_blocks;i++){ // Loop over all the blocks in the array
+    BlockTable *p_table = &p_memory->blocks; // Readability
 
-        sum += p_memory->p_blocks[i].size;
+    // The page of index points at the first block that starts in it, and at most BLOCK_MAP_PAGE_SIZE blocks start in a page
+    BlockId curr = p_memory->p_block_map[index / BLOCK_MAP_PAGE_SIZE] - 1; // NO_BLOCK if the page is empty
+    while (curr != NO_BLOCK && p_table->p_start_indices[curr] < index) {
+        curr = p_table->p_next[curr];
+    }
 
-        if (sum >= index) { // If the current block is the block that corresponds to the index given in bytes array
+    if (curr == NO_BLOCK || p_table->p_start_indices[curr] != index) return NO_BLOCK; // No block starts at this index
 
-            if (p_memory->p_blocks[i].free) { // The block here is free, so there is no block (effectively, logic treats this as padding) at this index
-                return -1; 
-            } 
-            *pp_block = &p_memory->p_blocks[i]; // Set the block pointer to point at the block found
-            return i; // Return index where this block was found in block array in case debugging is needed.
-        }
+    if (p_table->p_states[curr] & BLOCK_FREE) { // The block here is free, so there is no block (effectively, logic treats this as padding) at this index
+        return NO_BLOCK; 
     }
-    return -1; // No block found
-}
\ No newline at end of file
+    return curr;
+}
+
+// Finds the block (free or allocated) whose bytes include an index in the bytes array
+//
+// Input : A pointer to the memory and the lookup index
+//
+// Output : Returns the id of the block that the index is in, or NO_BLOCK if the index is outside of the bytes array
+BlockId find_block_containing(Memory *p_memory, size_t index) {
+    if (index >= p_memory->memory_size) return NO_BLOCK; // Outside of the bytes array
+
+    BlockTable *p_table = &p_memory->blocks; // Readability
+
+    // A big block can cover whole pages that no block starts in, so go back to the closest page that has a block starting before index.
+    // A block always starts at index 0, so page 0 stops the loop
+    size_t page = index / BLOCK_MAP_PAGE_SIZE;
+    while (p_memory->p_block_map[page] == 0 || p_table->p_start_indices[p_memory->p_block_map[page] - 1] > index) {
+        page--;
+    }
+
+    BlockId curr = p_memory->p_block_map[page] - 1;
+    while (p_table->p_next[curr] != NO_BLOCK && p_table->p_start_indices[p_table->p_next[curr]] <= index) {
+        curr = p_table->p_next[curr];
+    }
+    return curr;
+}
@@ -0,0 +1,264 @@
+#include "grow.h"
+
+// Gets the biggest size a memory can have with a backing, at startup and when it grows
+//
+// Input : Where the memory is allocated
+//
+// Output : Returns MAX_SIZE_STACK, MAX_SIZE_HEAP or MAX_SIZE_MMAP
+size_t backing_max_size(Memory_Backing backing) {
+    switch (backing) {
+        case STACK_BACKED: return MAX_SIZE_STACK;
+        case HEAP_BACKED: return MAX_SIZE_HEAP;
+        default: return MAX_SIZE_MMAP;
+    }
+}
+
+// Arguments parser for the grow_memory function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function grow_memory if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status grow_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function grow. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    long long size = strtoll(args[0],&endptr,10); // Convert the string argument that user gave to a long long based on decimal notation
+    size_t max_size = backing_max_size(p_memory->backing);
+    if(*endptr != '\0' || size <= 0 || (size_t)size > max_size - p_memory->memory_size) { // Invalid input
+        print_error("First argument in grow must be a positive integer (no decimal point) of at most %zu (so the memory is at most %zu bytes) <size>",
+            max_size - p_memory->memory_size, max_size);
+        return COMMAND_FAILED;
+    }
+
+    size_t old_size = p_memory->memory_size;
+    uint8_t success = grow_memory(p_memory, old_size + (size_t)size);
+    if (success) {
+        print_success("Grew the memory from %zu to %zu bytes successfully.", old_size, p_memory->memory_size);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Arguments parser for the grow_limit command, which sets up to what size my_malloc() grows the memory when it can't find a free block
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Sets memory->max_memory_size if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status grow_limit_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function grow_limit. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    if (p_memory->backing == STACK_BACKED) { // Same as grow_memory, but before the limit is set so it doesn't look like it is on
+        print_error("The memory is on the stack, so it can't grow. Start with the heap (or mmap) to use grow_limit.");
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    long long limit = strtoll(args[0],&endptr,10);
+    size_t max_size = backing_max_size(p_memory->backing);
+    if(*endptr != '\0' || limit < 0 || (size_t)limit > max_size) { // Invalid input
+        print_error("First argument in grow_limit must be a non negative integer (no decimal point) of at most %zu, 0 to turn it off <max size>", max_size);
+        return COMMAND_FAILED;
+    }
+
+    if (limit == 0 || (size_t)limit <= p_memory->memory_size) {
+        p_memory->max_memory_size = 0;
+        print_success("The memory will only grow with the grow command.");
+    } else {
+        p_memory->max_memory_size = (size_t)limit;
+        print_success("The memory will grow up to %lld bytes when malloc can't find a free block.", limit);
+    }
+    return COMMAND_SUCCEEDED;
+}
+
+// Called when my_malloc can't find a free block (and collecting garbage didn't help), grows the memory (if memory->max_memory_size allows it) and tries again
+//
+// Input : A pointer to the memory, a size of allocation, and a pointer to a pointer struct
+//
+// Output : Returns the result of my_malloc after the memory grew, or 0 if it can't grow
+uint8_t retry_after_grow(Memory *p_memory, size_t size, Pointer *p_ptr) {
+    size_t old_size = p_memory->memory_size;
+    if (p_memory->max_memory_size <= old_size) { // Off, or already as big as it may be
+        return 0;
+    }
+
+    // At least double, so a script that keeps allocating only grows (and copies the arrays) log2(size) times
+    size_t new_size = (old_size + size > 2 * old_size) ? old_size + size : 2 * old_size;
+    if (new_size > p_memory->max_memory_size) {
+        new_size = p_memory->max_memory_size;
+    }
+    if (!grow_memory(p_memory, new_size)) {
+        return 0;
+    }
+    printlnf("Grew the memory from %zu to %zu bytes to make room for %zu bytes.", old_size, new_size, size);
+    return my_malloc(p_memory, size, p_ptr); // If it still doesn't fit (like a buddy block that needs alignment) it grows again, until the limit
+}
+
+// Makes the memory bigger, the new bytes are a free block at the end that merges with the free block before it.
+// Blocks and pointers keep their ids and indices, only the arrays they are in can move
+//
+// Input : A pointer to the memory and its new size (more than its size)
+//
+// Output : Resizes the bytes array, its shadow, the block map, the pointer index and the block table and adds the new bytes as free memory,
+// returns a boolean (0 or 1) if it succeded or not (then the memory didn't change)
+uint8_t grow_memory(Memory *p_memory, size_t new_size) {
+    if (p_memory->backing == STACK_BACKED) { // A VLA can't change its size
+        print_error("The memory is on the stack, so it can't grow. Start with the heap (or mmap) to use grow.");
+        return 0;
+    }
+
+    size_t old_size = p_memory->memory_size;
+    size_t new_capacity = block_table_capacity(new_size);
+    if (new_capacity > p_memory->block_capacity && !grow_block_table(p_memory, new_capacity)) {
+        print_error("Could not grow the block table to %zu slots.", new_capacity);
+        return 0;
+    }
+
+    // Same sizes as main allocated
+    size_t old_map_size = (old_size + BLOCK_MAP_PAGE_SIZE - 1) / BLOCK_MAP_PAGE_SIZE * sizeof(BlockId);
+    size_t new_map_size = (new_size + BLOCK_MAP_PAGE_SIZE - 1) / BLOCK_MAP_PAGE_SIZE * sizeof(BlockId);
+    BlockId *p_block_map = resize_backing(p_memory, p_memory->p_block_map, old_map_size, new_map_size); // The new pages are zeroed, so they are empty
+    if (p_block_map == NULL) {
+        print_error("Could not grow the block map to %zu bytes.", new_map_size);
+        return 0;
+    }
+    p_memory->p_block_map = p_block_map;
+
+    size_t old_index_size = (old_size + POINTER_INDEX_PAGE_SIZE - 1) / POINTER_INDEX_PAGE_SIZE * sizeof(Pointer*);
+    size_t new_index_size = (new_size + POINTER_INDEX_PAGE_SIZE - 1) / POINTER_INDEX_PAGE_SIZE * sizeof(Pointer*);
+    Pointer **pp_pointer_index = resize_backing(p_memory, p_memory->pp_pointer_index, old_index_size, new_index_size); // The new lists are empty
+    if (pp_pointer_index == NULL) {
+        print_error("Could not grow the pointer index to %zu bytes.", new_index_size);
+        return 0;
+    }
+    p_memory->pp_pointer_index = pp_pointer_index;
+
+    uint64_t *p_shadow = resize_backing(p_memory, p_memory->p_shadow, shadow_storage_size(old_size), shadow_storage_size(new_size)); // The new bytes were never written
+    if (p_shadow == NULL) {
+        print_error("Could not grow the shadow of the memory to %zu bytes.", shadow_storage_size(new_size));
+        return 0;
+    }
+    p_memory->p_shadow = p_shadow;
+
+    uint8_t *p_bytes = resize_backing(p_memory, p_memory->p_bytes, old_size, new_size);
+    if (p_bytes == NULL) { // The bigger block map and table are only unused slots, so the memory still works with its old size
+        print_error("Could not grow the memory to %zu bytes.", new_size);
+        return 0;
+    }
+    p_memory->p_bytes = p_bytes;
+
+    p_memory->memory_size = new_size;
+    append_free_memory(p_memory, old_size, new_size - old_size);
+    if (p_memory->p_watch_pages != NULL) { // The page bitmap needs bits for the new pages
+        watch_rebuild_pages(p_memory);
+    }
+    return 1;
+}
+
+// Resizes one array of the memory the way its backing allocates (realloc or mremap)
+//
+// Input : A pointer to the memory, the array, its size in bytes and its new size in bytes
+//
+// Output : Returns a pointer to the resized array (the new bytes are zeroed), or NULL if it failed (then the array didn't change)
+void* resize_backing(Memory *p_memory, void *p_array, size_t old_size, size_t new_size) {
+    if (p_memory->backing != HEAP_BACKED) { // New mmap pages are already zeroed
+        return resize_pages(p_array, old_size, new_size);
+    }
+
+    uint8_t *p_resized = realloc(p_array, new_size);
+    if (p_resized != NULL) {
+        memset(p_resized + old_size, 0, new_size - old_size); // Like the mmap pages, so the block map doesn't need its own case
+    }
+    return p_resized;
+}
+
+// Moves the block table to a bigger storage, every array of the table starts at a different place when the capacity changes
+//
+// Input : A pointer to the memory and the new amount of slots
+//
+// Output : Copies the used slots of every array to a new storage and frees the old one,
+// returns a boolean (0 or 1) if it succeded or not (then the table didn't change)
+uint8_t grow_block_table(Memory *p_memory, size_t new_capacity) {
+    size_t old_storage_size = block_table_storage_size(p_memory->block_capacity);
+    size_t new_storage_size = block_table_storage_size(new_capacity);
+    void *p_storage = (p_memory->backing == HEAP_BACKED) ? malloc(new_storage_size)
+        : reserve_pages(new_storage_size, p_memory->backing == MMAP_HUGE_PAGES_BACKED);
+    if (p_storage == NULL) {
+        return 0;
+    }
+
+    BlockTable *p_old = &p_memory->blocks; // Readability
+    BlockTable new_table;
+    init_block_table(&new_table, p_storage, new_capacity);
+
+    // Slots after amount_of_used_slots were never used, so only the start of every array is copied
+    size_t used = p_memory->amount_of_used_slots;
+    memcpy(new_table.p_sizes, p_old->p_sizes, used * sizeof(size_t));
+    memcpy(new_table.p_start_indices, p_old->p_start_indices, used * sizeof(size_t));
+    memcpy(new_table.p_next, p_old->p_next, used * sizeof(BlockId));
+    memcpy(new_table.p_prev, p_old->p_prev, used * sizeof(BlockId));
+    memcpy(new_table.p_next_free, p_old->p_next_free, used * sizeof(BlockId));
+    memcpy(new_table.p_prev_free, p_old->p_prev_free, used * sizeof(BlockId));
+    memcpy(new_table.p_states, p_old->p_states, used * sizeof(uint8_t));
+
+    if (p_memory->backing == HEAP_BACKED) {
+        free(p_old->p_sizes); // The sizes array is at the start of the storage
+    } else {
+        release_pages(p_old->p_sizes, old_storage_size);
+    }
+    p_memory->blocks = new_table;
+    p_memory->block_capacity = new_capacity;
+    return 1;
+}
+
+// Adds free bytes after the last block, the way the allocator frees them
+//
+// Input : A pointer to the memory (whose memory_size already includes the bytes), where the bytes start and how many there are
+//
+// Output : Links a free block (with BUDDY, aligned powers of two) for the bytes after the last block and merges it with the free blocks before it
+void append_free_memory(Memory *p_memory, size_t start, size_t size) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    const Allocator *p_allocator = &arr_allocators[p_memory->allocator]; // The allocator chosen at startup
+    size_t end = start + size;
+
+    while (start < end) {
+        size_t piece = end - start;
+        if (p_memory->allocator == BUDDY) { // Every buddy block starts at a multiple of its size, like the blocks buddy_init made
+            piece = (size_t)1 << size_class(piece); // Biggest power of two that fits
+            while (start % piece != 0) {
+                piece >>= 1;
+            }
+        }
+
+        BlockId block = take_block_slot(p_memory);
+        if (block == NO_BLOCK) { // The table grew with the memory, so this only happens when it is at NO_BLOCK - 1 slots
+            print_error("Could not add %zu bytes at index %zu to the memory: all slots are taken.", end - start, start);
+            return;
+        }
+        BlockId last = find_block_containing(p_memory, start - 1); // Merging changes the last block, so it is found again every time
+        p_table->p_sizes[block] = piece;
+        p_table->p_start_indices[block] = start;
+        p_table->p_next[block] = NO_BLOCK;
+        p_table->p_prev[block] = last;
+        p_table->p_next_free[block] = NO_BLOCK;
+        p_table->p_prev_free[block] = NO_BLOCK;
+        p_table->p_states[block] = 0; // Allocated for a moment, so freeing it merges it like any other block
+        p_table->p_next[last] = block;
+        block_map_insert(p_memory, block);
+
+        if (p_allocator->p_free) { // Buddy blocks only merge with their buddy
+            p_allocator->p_free(p_memory, block);
+        } else {
+            p_table->p_states[block] = BLOCK_FREE;
+            free_bins_insert(p_memory, block);
+            if (p_table->p_states[last] & BLOCK_FREE) {
+                merge_block_right(p_memory, last);
+            }
+        }
+        start += piece;
+    }
+}
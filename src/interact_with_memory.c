@@ -1,14 +1,20 @@
 #include "interact_with_memory.h"
 
+#include <errno.h> // For the range errors of strtoull() and strtod()
+
+const Scalar_Type arr_scalar_types[AMOUNT_OF_SCALAR_TYPES] = {
+    {"u8", 1, 0}, {"u16", 2, 0}, {"u32", 4, 0}, {"u64", 8, 0}, {"f32", 4, 1}, {"f64", 8, 1}
+};
+
 // Arguments parser for the set_val function
 //
 // Input : A pointer to the memory and the amount of arguments and the arguments
 //
-// Output : Calls the function set_val if all the arguments are valid
-void set_val_command(Memory *p_memory, int args_c, char *args[10]) {
+// Output : Calls the function set_val if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status set_val_command(Memory *p_memory, int args_c, char *args[10]) {
     if (args_c != 2) {
         print_error("Wrong amount of arguments for function set_val. Expected 2 arguments but received %d arguments",args_c);
-        return;
+        return COMMAND_FAILED;
     }
 
     char *endptr;
@@ -16,19 +22,20 @@ void set_val_command(Memory *p_memory, int args_c, char *args[10]) {
     // In an array of uint8_t, every slot can be 0-255 TODO implement the ability to spread the data on a certain amount of bytes so user can enter bigger numbers
      if(*endptr != '\0' || value < 0 || value > 255) { 
         print_error("First argument in set_val must be an integer (no decimal dot) between 0-255 <value>, not %d.", value);
-        return;
+        return COMMAND_FAILED;
     }
     
     HashMap *p_pointers = p_memory->p_pointers; // Readability
     Pointer *p_ptr = (Pointer*)hashmap_get(p_pointers, args[1]);
     if (p_ptr == NULL) {
         print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.",args[1]);
-        return;
+        return COMMAND_FAILED;
     }
     uint8_t success = set_val(p_memory, (uint8_t)value, *p_ptr);
     if (success) {
         print_success("Set %ld to the value pointer %s is pointing at successfully.",value,args[1]);
     }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
 }
 
 // Given a pointer to a certain block, set the value of that block to the value passed along with the pointer
@@ -37,24 +44,258 @@ void set_val_command(Memory *p_memory, int args_c, char *args[10]) {
 //
 // Output : Sets the rightmost slot in the block to the value <value>
 uint8_t set_val(Memory *memory, uint8_t value,Pointer ptr) {
-    Block block;
-    Block *ptr2block = &block; // find_block function needs a pointer to a pointer to a block struct
-
-    int index_of_block = find_block(memory,ptr.start_index, &ptr2block);
+    size_t start, size;
+    BlockId block = resolve_pointer(memory, ptr, &start, &size); // Works for pointers to blocks and pointers into regions
+    if (block == NO_BLOCK) {
+        return 0;
+    }
     
-    if (index_of_block >= 0) {
-        block = memory->p_blocks[index_of_block]; // Double check to make sure you have the right block
+    memory->p_bytes[start + size - 1] = value; // Set the end of the allocated block to the value
+    shadow_set(memory->p_shadow, start + size - 1, 1); // Only that byte was written, the rest of the block keeps what it had
+    watch_write(memory, start + size - 1, 1, "set_val");
+    return 1;
+}
+
+// Arguments parser for the store_scalar function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function store_scalar if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status store_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 3 && args_c != 4) {
+        print_error("Wrong amount of arguments for function store. Expected 3 or 4 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    const Scalar_Type *p_type;
+    uint8_t big_endian;
+    if (!parse_scalar_type(args[0], &p_type, &big_endian)) {
+        print_error("First argument in store must be a type, u8, or u16, u32, u64, f32 or f64 followed by le or be (like u32le) <type>, not %s.", args[0]);
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    uint64_t bits;
+    errno = 0;
+    if (p_type->is_float) {
+        double value = strtod(args[1], &endptr);
+        if (*endptr != '\0' || endptr == args[1]) {
+            print_error("Second argument in store must be a number for type %s <value>, not %s.", args[0], args[1]);
+            return COMMAND_FAILED;
+        }
+        if (p_type->width == 4) { // Keep the bits of the float, not the number
+            float single = (float)value;
+            uint32_t single_bits;
+            memcpy(&single_bits, &single, sizeof(single_bits));
+            bits = single_bits;
+        } else {
+            memcpy(&bits, &value, sizeof(bits));
+        }
+    } else {
+        uint64_t max_value = (p_type->width == 8) ? UINT64_MAX : (((uint64_t)1 << (8 * p_type->width)) - 1);
+        bits = strtoull(args[1], &endptr, 10);
+        if (*endptr != '\0' || endptr == args[1] || args[1][0] == '-' || errno == ERANGE || bits > max_value) {
+            print_error("Second argument in store must be an integer between 0-%" PRIu64 " for type %s <value>, not %s.", max_value, args[0], args[1]);
+            return COMMAND_FAILED;
+        }
+    }
+
+    Pointer *p_ptr = (Pointer*)hashmap_get(p_memory->p_pointers, args[2]);
+    if (p_ptr == NULL) {
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.",args[2]);
+        return COMMAND_FAILED;
+    }
+
+    size_t offset = 0;
+    if (args_c == 4) {
+        errno = 0;
+        offset = strtoull(args[3], &endptr, 10);
+        if (*endptr != '\0' || endptr == args[3] || args[3][0] == '-' || errno == ERANGE) {
+            print_error("Fourth argument in store must be a positive integer <offset>, not %s.", args[3]);
+            return COMMAND_FAILED;
+        }
+    }
+
+    uint8_t success = store_scalar(p_memory, *p_ptr, offset, bits, p_type->width, big_endian);
+    if (success) {
+        print_success("Stored %s %s at offset %zu of pointer %s successfully.", args[0], args[1], offset, args[2]);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Arguments parser for the load_scalar function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function load_scalar if all the arguments are valid, prints the value and returns how the command ended (see Command_Status)
+Command_Status load_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 2 && args_c != 3) {
+        print_error("Wrong amount of arguments for function load. Expected 2 or 3 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    const Scalar_Type *p_type;
+    uint8_t big_endian;
+    if (!parse_scalar_type(args[0], &p_type, &big_endian)) {
+        print_error("First argument in load must be a type, u8, or u16, u32, u64, f32 or f64 followed by le or be (like u32le) <type>, not %s.", args[0]);
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_ptr = (Pointer*)hashmap_get(p_memory->p_pointers, args[1]);
+    if (p_ptr == NULL) {
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.",args[1]);
+        return COMMAND_FAILED;
+    }
+
+    size_t offset = 0;
+    if (args_c == 3) {
+        char *endptr;
+        errno = 0;
+        offset = strtoull(args[2], &endptr, 10);
+        if (*endptr != '\0' || endptr == args[2] || args[2][0] == '-' || errno == ERANGE) {
+            print_error("Third argument in load must be a positive integer <offset>, not %s.", args[2]);
+            return COMMAND_FAILED;
+        }
+    }
+
+    uint64_t bits;
+    if (!load_scalar(p_memory, *p_ptr, offset, p_type->width, big_endian, &bits)) {
+        return COMMAND_FAILED;
+    }
+
+    if (!p_type->is_float) {
+        print_success("Loaded %s %" PRIu64 " from offset %zu of pointer %s.", args[0], bits, offset, args[1]);
+    } else if (p_type->width == 4) {
+        float single;
+        uint32_t single_bits = (uint32_t)bits;
+        memcpy(&single, &single_bits, sizeof(single));
+        print_success("Loaded %s %.9g from offset %zu of pointer %s.", args[0], (double)single, offset, args[1]); // 9 digits are enough to read the same float back
     } else {
-        print_error("Could not find allocated block at address %d", ptr.start_index); // If the index was not found print an error message
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        print_success("Loaded %s %.17g from offset %zu of pointer %s.", args[0], value, offset, args[1]);
+    }
+    return COMMAND_SUCCEEDED;
+}
+
+// Writes a number of <width> bytes into what a pointer points at, without touching the other bytes of the block
+//
+// Input : A pointer to the memory, the pointer, the offset from the start of what it points at, the bits of the number (in the lowest <width> bytes),
+// the width and the byte order to write (1 for big endian)
+//
+// Output : Returns a boolean (0 or 1) if it succeded or not (the pointer is not valid or the number doesn't fit after the offset)
+uint8_t store_scalar(Memory *p_memory, Pointer ptr, size_t offset, uint64_t bits, uint8_t width, uint8_t big_endian) {
+    size_t index = scalar_index(p_memory, ptr, offset, width);
+    if (index == SIZE_MAX) {
         return 0;
     }
-    
-    ptr2block->uninitialized = 0; // Mark block as initialized
 
-    for (int i = ptr.start_index; i < ptr.start_index + block.size - 1;i++) {
-        memory->p_bytes[i] = 0;
+    uint8_t host_big_endian = host_is_big_endian();
+    if (big_endian != host_big_endian) {
+        bits = swap_scalar_bytes(bits, width);
+    }
+    // The lowest <width> bytes of bits are its first ones on a little endian machine and its last ones on a big endian machine.
+    // One memcpy of the whole number, the index doesn't have to be aligned
+    memcpy(p_memory->p_bytes + index, (uint8_t*)&bits + (host_big_endian ? sizeof(bits) - width : 0), width);
+
+    shadow_set(p_memory->p_shadow, index, width); // Only the bytes of the number, the rest of the block keeps what it had
+    watch_write(p_memory, index, width, "store");
+    return 1;
+}
+
+// Reads a number of <width> bytes from what a pointer points at
+//
+// Input : A pointer to the memory, the pointer, the offset from the start of what it points at, the width, the byte order to read (1 for big endian)
+// and where to put the bits of the number
+//
+// Output : Puts the bits in the lowest <width> bytes of *p_bits, returns a boolean (0 or 1) if it succeded or not
+uint8_t load_scalar(Memory *p_memory, Pointer ptr, size_t offset, uint8_t width, uint8_t big_endian, uint64_t *p_bits) {
+    size_t index = scalar_index(p_memory, ptr, offset, width);
+    if (index == SIZE_MAX) {
+        return 0;
+    }
+    if (!shadow_check(p_memory, index, width)) {
+        return 0;
     }
 
-    memory->p_bytes[ptr.start_index + block.size - 1] = value; // Set the end of the allocated block to the value
+    uint8_t host_big_endian = host_is_big_endian();
+    uint64_t bits = 0;
+    memcpy((uint8_t*)&bits + (host_big_endian ? sizeof(bits) - width : 0), p_memory->p_bytes + index, width);
+    *p_bits = (big_endian != host_big_endian) ? swap_scalar_bytes(bits, width) : bits;
     return 1;
-}
\ No newline at end of file
+}
+
+// Finds where a typed access starts in the bytes array, after checking that it is inside what the pointer points at
+//
+// Input : A pointer to the memory, the pointer, the offset and the width of the access
+//
+// Output : Returns the index of the first byte, or SIZE_MAX (after printing an error) if the access doesn't fit
+size_t scalar_index(Memory *p_memory, Pointer ptr, size_t offset, uint8_t width) {
+    size_t start, size;
+    if (resolve_pointer(p_memory, ptr, &start, &size) == NO_BLOCK) { // The block map finds the block, and works for pointers into regions too
+        return SIZE_MAX;
+    }
+    if (offset > size || size - offset < width) { // Written this way so a huge offset can't wrap around
+        print_error("%u bytes at offset %zu don't fit in the %zu bytes the pointer at address %" PRId64 " points at.", width, offset, size, ptr.start_index);
+        return SIZE_MAX;
+    }
+    return start + offset;
+}
+
+// Finds a type by its name and byte order, like u32le (a type of one byte, like u8, needs no byte order)
+//
+// Input : The name, and where to put the type and the byte order
+//
+// Output : Returns a boolean (0 or 1) if the name is a type or not
+uint8_t parse_scalar_type(const char *name, const Scalar_Type **pp_type, uint8_t *p_big_endian) {
+    for (size_t i = 0; i < AMOUNT_OF_SCALAR_TYPES; i++) {
+        if (arr_scalar_types[i].width == 1 && same_string(arr_scalar_types[i].p_name, name)) { // One byte has no order
+            *pp_type = &arr_scalar_types[i];
+            *p_big_endian = 0;
+            return 1;
+        }
+    }
+
+    size_t length = strlen(name);
+    if (length < 3) {
+        return 0;
+    }
+
+    const char *p_order = name + length - 2;
+    if (same_string(p_order, "le")) {
+        *p_big_endian = 0;
+    } else if (same_string(p_order, "be")) {
+        *p_big_endian = 1;
+    } else {
+        return 0;
+    }
+
+    for (size_t i = 0; i < AMOUNT_OF_SCALAR_TYPES; i++) {
+        if (strlen(arr_scalar_types[i].p_name) == length - 2 && strncmp(arr_scalar_types[i].p_name, name, length - 2) == 0) {
+            *pp_type = &arr_scalar_types[i];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Reverses the order of the lowest <width> bytes of a number, to turn the byte order of this machine into the other one
+//
+// Input : The bits and the width
+//
+// Output : Returns the bits with the lowest <width> bytes reversed (the other bytes are 0)
+uint64_t swap_scalar_bytes(uint64_t bits, uint8_t width) {
+    return __builtin_bswap64(bits) >> (64 - 8 * width); // The lowest byte becomes the highest, then move them back down
+}
+
+// Checks the byte order of the machine the program runs on
+//
+// Input : None
+//
+// Output : Returns 1 if the highest byte of a number is kept first, 0 if the lowest is
+uint8_t host_is_big_endian(void) {
+    const uint16_t one = 1;
+    uint8_t first_byte;
+    memcpy(&first_byte, &one, 1);
+    return first_byte == 0; // The compiler knows the answer, so this is a constant
+}
@@ -0,0 +1,461 @@
+#include "journal.h"
+
+#include <time.h> // For timespec_get()
+#ifdef __linux__
+#include <unistd.h> // For fsync()
+#else
+#include <io.h> // For _commit()
+#endif
+
+const char *arr_journal_commands[AMOUNT_OF_JOURNAL_COMMANDS] = {
+    "malloc", "free", "realloc", "malloc_many", "free_many", "gc", "gc_auto", "set_val", "new_pointer",
+    "arena_create", "arena_alloc", "arena_reset", "pool_create", "pool_alloc", "pool_free",
+    "nursery_create", "nursery_collect", "compact", "defrag", "grow", "grow_limit", "store", "mem_set",
+    "mem_copy", "mem_move", "vec_add", "vec_xor", "vec_and", "vec_or", "vec_shl"
+};
+
+// Arguments parser for the journal_start and journal_stop functions
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function journal_start with the path, or journal_stop for off, if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status journal_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function journal. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    Journal *p_journal = &p_memory->journal; // Readability
+    if (same_string(args[0], "off")) {
+        if (p_journal->p_file == NULL) {
+            print_error("There is no journal to stop.");
+            return COMMAND_FAILED;
+        }
+        journal_stop(p_memory);
+        print_success("Stopped the journal %s successfully.", p_journal->arr_path);
+        return COMMAND_SUCCEEDED;
+    }
+
+    if (p_journal->p_file != NULL) {
+        print_error("The commands are already journaled to %s, use journal off before starting another journal.", p_journal->arr_path);
+        return COMMAND_FAILED;
+    }
+    if (strlen(args[0]) + strlen(".snap") >= JOURNAL_PATH_SIZE) {
+        print_error("The path of the journal can be at most %zu characters <path>", JOURNAL_PATH_SIZE - strlen(".snap") - 1);
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = journal_start(p_memory, args[0]);
+    if (success) {
+        print_success("Journaling the commands to %s on top of the snapshot %s.snap successfully.", args[0], args[0]);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Arguments parser for the journal_replay function
+//
+// Input : A pointer to the memory, a pointer to the commands hashmap and the amount of arguments and the arguments
+//
+// Output : Calls the function journal_replay if all the arguments are valid
+void recover_command(Memory *p_memory, HashMap *p_cmds, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function recover. Expected 1 argument but received %d arguments",args_c);
+        return;
+    }
+    if (p_memory->journal.p_file != NULL) { // The replayed commands would not be journaled
+        print_error("The commands are journaled to %s, use journal off before recovering.", p_memory->journal.arr_path);
+        return;
+    }
+
+    size_t replayed, mismatched;
+    uint8_t success = journal_replay(p_memory, p_cmds, args[0], &replayed, &mismatched);
+    if (success) {
+        print_success("Recovered the memory from %s successfully, replayed %zu commands on top of its snapshot.", args[0], replayed);
+        if (mismatched > 0) {
+            printlnf("%zu of the commands ended differently than when they were recorded, the snapshot might not be the one the journal started from.", mismatched);
+        }
+    }
+}
+
+// Starts recording every command that changes the memory, on top of a snapshot of the memory as it is now (saved to <path>.snap)
+//
+// Input : A pointer to the memory and the path of the journal
+//
+// Output : Saves the snapshot and writes the header of the journal, returns a boolean (0 or 1) if it succeded or not
+uint8_t journal_start(Memory *p_memory, const char *path) {
+    char snapshot_path[JOURNAL_PATH_SIZE];
+    snprintf(snapshot_path, sizeof(snapshot_path), "%s.snap", path);
+
+    size_t file_size;
+    if (!snapshot_save(p_memory, snapshot_path, &file_size)) { // The journal only has what changed after it started, so it needs the memory from before
+        return 0;
+    }
+    strcpy(p_memory->journal.arr_path, path);
+    return journal_checkpoint(p_memory, snapshot_path);
+}
+
+// Stops the journal, after syncing what is left of it to the disk
+//
+// Input : A pointer to the memory
+//
+// Output : Writes the last defrag steps, syncs and closes the journal file
+void journal_stop(Memory *p_memory) {
+    Journal *p_journal = &p_memory->journal; // Readability
+    if (p_journal->defrag_steps > 0) { // Steps after the last command are only written when the journal stops
+        journal_write_record(p_memory, JOURNAL_NO_COMMAND, 0, 0, NULL);
+    }
+    if (p_journal->p_file == NULL) { // Writing failed and closed it
+        return;
+    }
+    journal_sync(p_memory);
+    fclose(p_journal->p_file);
+    p_journal->p_file = NULL;
+}
+
+// Closes the journal of this process without writing to it, so a fork doesn't write to the journal of the memory it was forked from
+//
+// Input : A pointer to the memory
+//
+// Output : memory->journal.p_file is NULL
+void journal_detach(Memory *p_memory) {
+    if (p_memory->journal.p_file != NULL) {
+        fclose(p_memory->journal.p_file); // Every record was flushed when it was written, so this only closes this process's copy of the file
+        p_memory->journal.p_file = NULL;
+    }
+}
+
+// Starts the journal over on top of a new snapshot, the records before it are not needed to recover anymore
+//
+// Input : A pointer to the memory and the path of the snapshot (that was just saved or loaded)
+//
+// Output : Writes a journal with only a header to <path>.tmp, syncs it and renames it over the journal (so a crash leaves the old or the new one whole),
+// returns a boolean (0 or 1) if it succeded or not (then the journal is stopped)
+uint8_t journal_checkpoint(Memory *p_memory, const char *snapshot_path) {
+    Journal *p_journal = &p_memory->journal; // Readability
+    if (p_journal->p_file != NULL) {
+        fclose(p_journal->p_file);
+        p_journal->p_file = NULL;
+    }
+
+    // The snapshot has to be on the disk before a journal that starts from it
+    FILE *p_snapshot = fopen(snapshot_path, "ab");
+    if (p_snapshot != NULL) {
+        sync_file(p_snapshot);
+        fclose(p_snapshot);
+    }
+
+    size_t path_length = strlen(snapshot_path);
+    if (path_length >= JOURNAL_PATH_SIZE) { // journal_replay reads it into a buffer of this size
+        print_error("The path of the snapshot is longer than %d characters, the journal is stopped.", JOURNAL_PATH_SIZE - 1);
+        return 0;
+    }
+    Journal_Header header = {0};
+    memcpy(header.arr_magic, JOURNAL_MAGIC, sizeof(header.arr_magic));
+    header.version = JOURNAL_VERSION;
+    header.snapshot_path_length = (uint32_t)path_length;
+    header.allocator = (uint32_t)p_memory->allocator;
+    header.gc_auto = (uint32_t)p_memory->gc_auto;
+    header.defrag_budget = p_memory->defrag_budget;
+    header.defrag_position = p_memory->defrag_position;
+    header.max_memory_size = p_memory->max_memory_size;
+    header.next_fit_start = (p_memory->next_fit_rover == NO_BLOCK) ? UINT64_MAX : p_memory->blocks.p_start_indices[p_memory->next_fit_rover];
+
+    char temp_path[JOURNAL_PATH_SIZE + 4];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", p_journal->arr_path);
+    FILE *p_file = fopen(temp_path, "wb");
+    if (p_file == NULL) {
+        print_error("Could not open the file %s for writing, the journal is stopped.", temp_path);
+        return 0;
+    }
+    uint8_t success = fwrite(&header, sizeof(header), 1, p_file) == 1 && fwrite(snapshot_path, 1, path_length, p_file) == path_length;
+    sync_file(p_file);
+    success = (fclose(p_file) == 0) && success;
+
+#ifdef __linux__
+    success = success && rename(temp_path, p_journal->arr_path) == 0; // Replaces the old journal in one step
+#else
+    success = success && MoveFileExA(temp_path, p_journal->arr_path, MOVEFILE_REPLACE_EXISTING); // rename() fails on Windows if the journal exists
+#endif
+    if (!success) {
+        remove(temp_path);
+        print_error("Could not write the journal %s, the journal is stopped.", p_journal->arr_path);
+        return 0;
+    }
+
+    p_journal->p_file = fopen(p_journal->arr_path, "ab");
+    if (p_journal->p_file == NULL) {
+        print_error("Could not open the journal %s, the journal is stopped.", p_journal->arr_path);
+        return 0;
+    }
+    p_journal->defrag_steps = 0; // They happened before the snapshot
+    p_journal->last_sync_ms = journal_now_ms();
+    return 1;
+}
+
+// Called by execute_command after every command that printed a success or an error, records it if it changes the memory
+//
+// Input : A pointer to the memory, the amount of arguments and the arguments (with the name of the command first)
+// and if the command printed a success
+//
+// Output : Appends a record of the command (or a checkpoint after snapshot_save and snapshot_load), does nothing if the journal is off
+void journal_after_command(Memory *p_memory, int args_c, char *args[10], uint8_t succeeded) {
+    if (p_memory->journal.p_file == NULL) {
+        return;
+    }
+
+    if (same_string(args[0], "snapshot_save") || same_string(args[0], "snapshot_load")) { // The memory is the snapshot now
+        if (succeeded) {
+            journal_checkpoint(p_memory, args[1]);
+        }
+        return;
+    }
+
+    uint8_t command = find_journal_command(args[0]);
+    if (command == JOURNAL_NO_COMMAND) { // Doesn't change the memory (like visualize_blocks)
+        return;
+    }
+    // Failed commands are recorded as well, a malloc that fails can still collect garbage or grow the memory on the way
+    journal_write_record(p_memory, command, succeeded ? JOURNAL_SUCCEEDED : 0, args_c - 1, args + 1);
+}
+
+// Appends one record to the journal and syncs the journal if JOURNAL_SYNC_INTERVAL_MS passed since the last sync
+//
+// Input : A pointer to the memory, the index of the command (or JOURNAL_NO_COMMAND), the flags, and the amount of arguments and the arguments
+// (without the name of the command)
+//
+// Output : Writes the record with memory->journal.defrag_steps and sets them to 0, returns a boolean (0 or 1) if it succeded or not
+uint8_t journal_write_record(Memory *p_memory, uint8_t command, uint8_t flags, int args_c, char **args) {
+    Journal *p_journal = &p_memory->journal; // Readability
+    uint8_t arr_record[sizeof(Journal_Record) + MAX_INPUT_SIZE + 10 * sizeof(uint16_t)]; // The arguments are parts of one input line
+    uint8_t *p_payload = arr_record + sizeof(Journal_Record);
+
+    size_t payload_length = 0;
+    for (int i = 0; i < args_c; i++) {
+        uint16_t length = (uint16_t)strlen(args[i]);
+        memcpy(p_payload + payload_length, &length, sizeof(length));
+        memcpy(p_payload + payload_length + sizeof(length), args[i], length);
+        payload_length += sizeof(length) + length;
+    }
+
+    Journal_Record record = {
+        .defrag_steps = p_journal->defrag_steps,
+        .payload_length = (uint16_t)payload_length,
+        .command = command,
+        .flags = flags
+    };
+    record.checksum = journal_checksum((const uint8_t*)&record + sizeof(record.checksum), sizeof(record) - sizeof(record.checksum), 2166136261u);
+    record.checksum = journal_checksum(p_payload, payload_length, record.checksum);
+    memcpy(arr_record, &record, sizeof(record));
+
+    // One write for the whole record, and flushed right away so it survives if the program crashes
+    size_t record_size = sizeof(record) + payload_length;
+    if (fwrite(arr_record, 1, record_size, p_journal->p_file) != record_size || fflush(p_journal->p_file) != 0) {
+        print_error("Could not write to the journal %s, the journal is stopped.", p_journal->arr_path);
+        fclose(p_journal->p_file);
+        p_journal->p_file = NULL;
+        return 0;
+    }
+    p_journal->defrag_steps = 0;
+
+    // Syncing costs milliseconds, so the records of a script that runs fast share one sync (group commit)
+    if (journal_now_ms() - p_journal->last_sync_ms >= JOURNAL_SYNC_INTERVAL_MS) {
+        journal_sync(p_memory);
+    }
+    return 1;
+}
+
+// Syncs the journal file to the disk
+//
+// Input : A pointer to the memory
+//
+// Output : Flushes and syncs the journal file, and sets memory->journal.last_sync_ms
+void journal_sync(Memory *p_memory) {
+    sync_file(p_memory->journal.p_file);
+    p_memory->journal.last_sync_ms = journal_now_ms();
+}
+
+// Writes everything that was written to a file to the disk, so it is not lost if the system crashes
+//
+// Input : A pointer to the file
+//
+// Output : Flushes the buffer of the file and waits until the system wrote the file to the disk
+void sync_file(FILE *p_file) {
+    fflush(p_file);
+#ifdef __linux__
+    fsync(fileno(p_file));
+#else
+    _commit(_fileno(p_file));
+#endif
+}
+
+// Replays a journal on top of the snapshot it starts from
+//
+// Input : A pointer to the memory, a pointer to the commands hashmap, the path of the journal and where to put how many commands were replayed
+// and how many of them didn't end the way they ended when they were recorded
+//
+// Output : Loads the snapshot, sets the settings from the header and runs the commands, stops at the first record that is cut off or doesn't match its checksum,
+// returns a boolean (0 or 1) if it succeded or not
+uint8_t journal_replay(Memory *p_memory, HashMap *p_cmds, const char *path, size_t *p_replayed, size_t *p_mismatched) {
+    size_t file_size;
+    const uint8_t *p_file = map_file(path, &file_size);
+    if (p_file == NULL) {
+        print_error("Could not read the journal %s.", path);
+        return 0;
+    }
+
+    const uint8_t *p_cursor = p_file;
+    const uint8_t *p_end = p_file + file_size;
+    const uint8_t *p_header_bytes = snapshot_skip(&p_cursor, p_end, sizeof(Journal_Header));
+    Journal_Header header;
+    if (p_header_bytes == NULL || memcmp(p_header_bytes, JOURNAL_MAGIC, sizeof(header.arr_magic)) != 0) {
+        print_error("The file %s is not a journal.", path);
+        unmap_file(p_file, file_size);
+        return 0;
+    }
+    memcpy(&header, p_header_bytes, sizeof(header));
+    if (header.version != JOURNAL_VERSION) {
+        print_error("The journal is version %u, this version of Bytethon reads version %d.", header.version, JOURNAL_VERSION);
+        unmap_file(p_file, file_size);
+        return 0;
+    }
+    if (header.allocator != (uint32_t)p_memory->allocator) { // Checked before the snapshot is loaded, which would refuse it as well
+        print_error("The journal was recorded with a different allocator, the memory uses %s.", arr_allocators[p_memory->allocator].p_name);
+        unmap_file(p_file, file_size);
+        return 0;
+    }
+
+    char snapshot_path[JOURNAL_PATH_SIZE];
+    const uint8_t *p_path = snapshot_skip(&p_cursor, p_end, header.snapshot_path_length);
+    if (p_path == NULL || header.snapshot_path_length >= JOURNAL_PATH_SIZE) {
+        print_error("The journal %s is cut off before the path of its snapshot.", path);
+        unmap_file(p_file, file_size);
+        return 0;
+    }
+    memcpy(snapshot_path, p_path, header.snapshot_path_length);
+    snapshot_path[header.snapshot_path_length] = '\0';
+    if (!snapshot_load(p_memory, snapshot_path)) {
+        unmap_file(p_file, file_size);
+        return 0;
+    }
+
+    // The settings as they were when the snapshot was taken, the commands after it ran with them
+    p_memory->gc_auto = (Gc_Mode)header.gc_auto;
+    p_memory->defrag_budget = (size_t)header.defrag_budget;
+    p_memory->defrag_position = (header.defrag_position <= p_memory->memory_size) ? (size_t)header.defrag_position : 0;
+    p_memory->max_memory_size = (p_memory->backing == STACK_BACKED) ? 0 : (size_t)header.max_memory_size;
+    p_memory->next_fit_rover = (header.next_fit_start < p_memory->memory_size) ? find_block_containing(p_memory, (size_t)header.next_fit_start) : NO_BLOCK;
+
+    *p_replayed = 0;
+    *p_mismatched = 0;
+    char arr_arguments[MAX_INPUT_SIZE + 10]; // The arguments with a '\0' after every one of them
+    const uint8_t *p_record_start = p_cursor;
+    while (p_cursor < p_end) {
+        p_record_start = p_cursor;
+        const uint8_t *p_record_bytes = snapshot_skip(&p_cursor, p_end, sizeof(Journal_Record));
+        if (p_record_bytes == NULL) {
+            break;
+        }
+        Journal_Record record;
+        memcpy(&record, p_record_bytes, sizeof(record));
+        const uint8_t *p_payload = snapshot_skip(&p_cursor, p_end, record.payload_length);
+        if (p_payload == NULL) {
+            break;
+        }
+        uint32_t checksum = journal_checksum(p_record_bytes + sizeof(record.checksum), sizeof(record) - sizeof(record.checksum), 2166136261u);
+        checksum = journal_checksum(p_payload, record.payload_length, checksum);
+        if (checksum != record.checksum || (record.command >= AMOUNT_OF_JOURNAL_COMMANDS && record.command != JOURNAL_NO_COMMAND)) {
+            break;
+        }
+
+        int args_c = 0;
+        char *args[10];
+        size_t offset = 0, used = 0;
+        while (offset + sizeof(uint16_t) <= record.payload_length && args_c < 10) {
+            uint16_t length;
+            memcpy(&length, p_payload + offset, sizeof(length));
+            offset += sizeof(length);
+            if (offset + length > record.payload_length || used + length + 1 > sizeof(arr_arguments)) {
+                break;
+            }
+            memcpy(arr_arguments + used, p_payload + offset, length);
+            arr_arguments[used + length] = '\0';
+            args[args_c++] = arr_arguments + used;
+            offset += length;
+            used += length + 1;
+        }
+        if (offset != record.payload_length) { // The checksum matched, so only a different version would write this
+            break;
+        }
+
+        for (uint32_t i = 0; i < record.defrag_steps; i++) {
+            defrag_step(p_memory);
+        }
+        if (record.command == JOURNAL_NO_COMMAND) {
+            p_record_start = p_cursor;
+            continue;
+        }
+
+        const char *name = arr_journal_commands[record.command];
+        Command *p_cmd = (Command*)hashmap_get(p_cmds, name);
+        if (p_cmd == NULL || (size_t)args_c < p_cmd->amount_of_arguments || (size_t)args_c > p_cmd->amount_of_arguments + p_cmd->amount_of_optional_arguments) {
+            break;
+        }
+        Command_Status status = COMMAND_SUCCEEDED;
+        if (record.command == find_journal_command("new_pointer")) { // The command asks before it overwrites a pointer, it was confirmed when it was recorded
+            new_pointer(p_memory, args[0]);
+        } else {
+            status = p_cmd->memo_cmd(p_memory, args_c, args);
+        }
+        (*p_replayed)++;
+
+        uint8_t succeeded = status == COMMAND_SUCCEEDED;
+        if (succeeded != (record.flags & JOURNAL_SUCCEEDED)) {
+            (*p_mismatched)++;
+        }
+        p_record_start = p_cursor;
+    }
+
+    if (p_record_start < p_end) { // Normal after a crash, the last record was being written
+        printlnf("The last %zu bytes of the journal are cut off or damaged, the commands in them were not replayed.", (size_t)(p_end - p_record_start));
+    }
+    unmap_file(p_file, file_size);
+    return 1;
+}
+
+// Finds the index of a command in arr_journal_commands
+//
+// Input : The name of the command
+//
+// Output : Returns the index, or JOURNAL_NO_COMMAND if the command doesn't change the memory
+uint8_t find_journal_command(const char *name) {
+    for (uint8_t i = 0; i < AMOUNT_OF_JOURNAL_COMMANDS; i++) {
+        if (same_string(arr_journal_commands[i], name)) {
+            return i;
+        }
+    }
+    return JOURNAL_NO_COMMAND;
+}
+
+// Checksum of the bytes of a record (FNV-1a), continues from the checksum of the bytes before them
+//
+// Input : A pointer to the bytes, how many there are and the checksum so far (2166136261 for the first bytes)
+//
+// Output : Returns the checksum
+uint32_t journal_checksum(const uint8_t *p_bytes, size_t size, uint32_t checksum) {
+    for (size_t i = 0; i < size; i++) {
+        checksum ^= p_bytes[i];
+        checksum *= 16777619u;
+    }
+    return checksum;
+}
+
+// Gets the time in milliseconds, to know when to sync the journal
+//
+// Input : None
+//
+// Output : Returns the milliseconds since the epoch
+uint64_t journal_now_ms(void) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
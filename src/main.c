@@ -1,112 +1,223 @@
 #include "general_management.h"
 
-#define MAX_SIZE_STACK ((1 << 19) / sizeof(Block))  // 2^19 = 512 KB
-#define MAX_SIZE_HEAP ((1 << 29) / sizeof(Block)) // 2^29 = 512 MB
-uint8_t get_memory_type(){
+#ifdef __linux__
+#define AMOUNT_OF_BACKINGS 4 // The mmap options are only offered where mmap exists
+#else
+#define AMOUNT_OF_BACKINGS 2
+#endif
+
+Memory_Backing get_memory_type(){
     printlnf("Please choose where you want to allocate your memory for the simulation: \n");
     printlnf(" 1. Stack: Smaller, but faster \n");
     printlnf(" 2. Heap, Larger but slower. \n");
+#ifdef __linux__
+    printlnf(" 3. Reserved (mmap): Up to 64 GB, starts instantly, pages are only committed when they are used. \n");
+    printlnf(" 4. Reserved with huge pages: Like 3, with transparent huge pages for big memories. \n");
+#endif
     printlnf("Heap option also uses c built-in malloc and free, so for seeing the project fully \nwithout builtin malloc/free (excluding dynamic hashes for the cli commands) use stack.");
 
     // The reply should not be more than 10 charcters
     char option[10];
-    uint8_t is_heap_allocated;
+    uint8_t backing;
+    do {
+        fgets(option,sizeof(option),stdin);
+        int valid = sscanf(option,"%hhu", &backing); 
+
+        if (valid && backing >= 1 && backing <= AMOUNT_OF_BACKINGS){
+            return (Memory_Backing)(backing - 1); // Options start from 1, the enum starts from 0
+        }
+
+        printlnf("\033[4;38;5;52m[ERROR]\033[24m\033[38;5;196m Please enter an option from 1 to %d.\033[0m", AMOUNT_OF_BACKINGS); // Red error prefix + red error message
+
+    } while (1);
+}
+
+Allocator_Type get_allocator_type(){
+    printlnf("Please choose how malloc should search for free memory: \n");
+    for (int i = 0; i < AMOUNT_OF_ALLOCATORS; i++) {
+        printlnf(" %d. %s: %s. \n", i + 1, arr_allocators[i].p_name, arr_allocators[i].p_description);
+    }
+
+    // The reply should not be more than 10 charcters
+    char option[10];
+    uint8_t allocator;
     do {
         fgets(option,sizeof(option),stdin);
-        int valid = sscanf(option,"%hhu", &is_heap_allocated); 
+        int valid = sscanf(option,"%hhu", &allocator); 
 
-        if (valid && (is_heap_allocated == 1 || is_heap_allocated == 2)){
-            is_heap_allocated--; // (convert into boolean: 1 (Stack option) -> 0 (false)...)
-            return is_heap_allocated;
+        if (valid && allocator >= 1 && allocator <= AMOUNT_OF_ALLOCATORS){
+            return (Allocator_Type)(allocator - 1); // Options start from 1, the enum starts from 0
         }
 
-        printlnf("\033[4;38;5;52m[ERROR]\033[24m\033[38;5;196m Please enter an option, 1 or 2.\033[0m"); // Red error prefix + red error message
+        printlnf("\033[4;38;5;52m[ERROR]\033[24m\033[38;5;196m Please enter an option from 1 to %d.\033[0m", AMOUNT_OF_ALLOCATORS); // Red error prefix + red error message
 
     } while (1);
 }
 
-size_t get_size_of_memory(uint8_t is_heap_allocated) {
+size_t get_size_of_memory(Memory_Backing backing) {
     size_t size;
     char input[50]; // Buffer for input
+    size_t max_size = backing_max_size(backing);
 
     do {
-        printlnf("Please enter a number from 1 - %zu for the size of your memory in the simulation: ", is_heap_allocated ?  MAX_SIZE_HEAP : MAX_SIZE_STACK);
+        printlnf("Please enter a number from 1 - %zu for the size of your memory in the simulation: ", max_size);
         fgets(input, sizeof(input), stdin);
         
         int success = sscanf(input, "%zu", &size); // Read input as size_t
         
         // If sscanf fails or if input is out of range, show the input and explain the error
-        if (success && size > 0 && size <= (is_heap_allocated == 1 ? MAX_SIZE_HEAP : MAX_SIZE_STACK)) {
+        if (success && size > 0 && size <= max_size) {
             return size; // Valid input, return the size
         } else {
             // Show the user their invalid input
             input[strcspn(input, "\n")] = '\0';  // Remove trailing newline
-            print_error("Invalid input: '%s'. Please enter a valid number between 1 and %zu!", input, is_heap_allocated ? MAX_SIZE_HEAP : MAX_SIZE_STACK );
+            print_error("Invalid input: '%s'. Please enter a valid number between 1 and %zu!", input, max_size);
         }
     } while (1); // Repeat until valid input
 }
 
 int main(){
-    uint8_t is_heap_allocated = get_memory_type();
+    Memory_Backing backing = get_memory_type();
+    uint8_t is_stack_allocated = backing == STACK_BACKED;
     // Can make an array the size that is inputted here (can't use constructor function without using malloc)
-    size_t size_of_memory = get_size_of_memory(is_heap_allocated);
+    size_t size_of_memory = get_size_of_memory(backing);
+    Allocator_Type allocator = get_allocator_type();
 
     HashMap commands = init_commands(100); // Bucket size of the hashmap for commands
 
     HashMap pointers = init_hashmap(10); // Bucket size is 10
 
-    Block *p_blocks;  // Declare the pointer for blocks (this will be used for heap allocation)
+    HashMap regions = init_hashmap(10); // Arenas (and other regions) by name, bucket size is 10
+
+    HashMap watches = init_hashmap(10); // Watchpoints by the name of their pointer, bucket size is 10
+
+    size_t *p_block_storage; // Declare the pointer for the block table's arrays (this will be used for heap allocation)
     uint8_t *p_bytes; // Declare the pointer for bytes (this will be used for heap allocation)
+    BlockId *p_block_map; // Declare the pointer for the block map (this will be used for heap allocation)
+    uint64_t *p_shadow; // Declare the pointer for the shadow of the bytes (this will be used for heap allocation)
+    Pointer **pp_pointer_index; // Declare the pointer for the pointer index (this will be used for heap allocation)
+    size_t block_map_size = (size_of_memory + BLOCK_MAP_PAGE_SIZE - 1) / BLOCK_MAP_PAGE_SIZE; // One slot for every page, rounded up
+    size_t pointer_index_size = (size_of_memory + POINTER_INDEX_PAGE_SIZE - 1) / POINTER_INDEX_PAGE_SIZE; // One list for every page, rounded up
+    size_t block_capacity = block_table_capacity(size_of_memory); // One slot for every byte of memory
+    size_t block_storage_size = block_table_storage_size(block_capacity); // In bytes
+    size_t shadow_size = shadow_storage_size(size_of_memory); // In bytes, one bit for every byte of memory
     
-    // Stack allocation for blocks, because c is annoying I need to create stack arrays outside of if blocks, and replace them later with malloc if I want both options
-    Block blocks_stack[is_heap_allocated? 1 : size_of_memory];  
+    // Stack allocation for the block table, because c is annoying I need to create stack arrays outside of if blocks, and replace them later with malloc if I want both options
+    // An array of size_t (rounded up) so the 64 bit arrays of the table are aligned
+    size_t block_storage_stack[is_stack_allocated ? (block_storage_size + sizeof(size_t) - 1) / sizeof(size_t) : 1];  
 
    // Stack allocation for bytes, because c is annoying I need to create stack arrays outside of if blocks, and replace them later with malloc if I want both options
-    uint8_t bytes_stack[is_heap_allocated? 1 : size_of_memory]; 
+    uint8_t bytes_stack[is_stack_allocated ? size_of_memory : 1]; 
+
+    // Stack allocation for the block map, same as above
+    BlockId block_map_stack[is_stack_allocated ? block_map_size : 1];
+
+    // Stack allocation for the shadow, same as above
+    uint64_t shadow_stack[is_stack_allocated ? shadow_size / sizeof(uint64_t) : 1];
+
+    // Stack allocation for the pointer index, same as above
+    Pointer *pointer_index_stack[is_stack_allocated ? pointer_index_size : 1];
 
     // Assign stack arrays to pointers
-    p_blocks = blocks_stack; 
+    p_block_storage = block_storage_stack; 
     p_bytes = bytes_stack;
-
-    if (is_heap_allocated) {
+    p_block_map = block_map_stack;
+    p_shadow = shadow_stack;
+    pp_pointer_index = pointer_index_stack;
+
+    if (is_stack_allocated) {
+        memset(p_block_map, 0, block_map_size * sizeof(BlockId)); // No block starts anywhere yet
+        memset(p_shadow, 0, shadow_size); // No byte was written yet
+        memset(pp_pointer_index, 0, pointer_index_size * sizeof(Pointer*)); // No pointer points anywhere yet
+    } else if (backing == HEAP_BACKED) {
         // Heap allocation for both blocks and bytes
-        p_blocks = (Block *)malloc(size_of_memory * sizeof(Block)); // Allocate memory for blocks on the heap
+        p_block_storage = (size_t *)malloc(block_storage_size); // Allocate memory for the block table on the heap
         p_bytes = (uint8_t *)malloc(size_of_memory * sizeof(uint8_t)); // Allocate memory for bytes on the heap
-        if (p_blocks == NULL || p_bytes == NULL) {
-            // Handle allocation failure (for safety)
-            printf("Memory allocation failed!\n");
-            exit(1);
-        }
-    } 
+        p_block_map = (BlockId *)calloc(block_map_size, sizeof(BlockId)); // Zeroed, so no block starts anywhere yet
+        p_shadow = (uint64_t *)calloc(shadow_size, 1); // Zeroed, so no byte was written yet
+        pp_pointer_index = (Pointer **)calloc(pointer_index_size, sizeof(Pointer*)); // Zeroed, so every list is empty
+    } else {
+        // Only address space is reserved, the pages of every array are committed (and zeroed) when they are first touched,
+        // so the time to start doesn't depend on the size and only the used part of the metadata takes memory
+        uint8_t huge_pages = backing == MMAP_HUGE_PAGES_BACKED;
+        p_block_storage = (size_t *)reserve_pages(block_storage_size, huge_pages);
+        p_bytes = (uint8_t *)reserve_pages(size_of_memory, huge_pages);
+        p_block_map = (BlockId *)reserve_pages(block_map_size * sizeof(BlockId), huge_pages); // Zero pages, so no block starts anywhere yet
+        p_shadow = (uint64_t *)reserve_pages(shadow_size, huge_pages);
+        pp_pointer_index = (Pointer **)reserve_pages(pointer_index_size * sizeof(Pointer*), huge_pages);
+    }
+    if (p_block_storage == NULL || p_bytes == NULL || p_block_map == NULL || p_shadow == NULL || pp_pointer_index == NULL) {
+        // Handle allocation failure (for safety)
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
     
     // Now, you can use `blocks` and `bytes` throughout the function
     
-    
-    p_blocks[0] = (Block){ // Initiailize the first index as a big free uninitialized block
-        .size = size_of_memory, // With the size the requested
-        .start_index =  0, // Starts at the index 0 in the memory (the actual memory, not the blocks memory)
-        .p_prev = NULL, // No previous block
-        .p_next = NULL, // No next block yet
-        .free = 1, // It is free
-        .uninitialized = 1 // And it is uninitialzed
-    };
+    BlockTable blocks;
+    init_block_table(&blocks, p_block_storage, block_capacity); // Point the arrays of the table into the storage
+
+    // Initiailize the first slot as a big free uninitialized block
+    blocks.p_sizes[0] = size_of_memory; // With the size the requested
+    blocks.p_start_indices[0] = 0; // Starts at the index 0 in the memory (the actual memory, not the blocks memory)
+    blocks.p_prev[0] = NO_BLOCK; // No previous block
+    blocks.p_next[0] = NO_BLOCK; // No next block yet
+    blocks.p_prev_free[0] = NO_BLOCK; // Alone in its size class bin
+    blocks.p_next_free[0] = NO_BLOCK;
+    blocks.p_states[0] = BLOCK_FREE; // It is free, and free bytes are uninitialized (their bits in the shadow are off)
 
     Memory memory = {
         .p_bytes = p_bytes, // Initialize the memory with bytes as mem.bytes
-        .p_blocks = p_blocks, // The blocks array as the mem.blocks
+        .blocks = blocks, // The block table as the mem.blocks
+        .first_block = 0, // The first block is the head of the linked list
+        .free_slots = NO_BLOCK, // No block was merged away yet
+        .amount_of_used_slots = 1, // Only the first slot is used
+        .block_capacity = block_capacity,
+        .p_shadow = p_shadow,
+        .p_block_map = p_block_map,
+        .pp_pointer_index = pp_pointer_index,
         .amount_of_blocks = 1, // There is only one block currently
         .memory_size = size_of_memory, // The size of the memory
         .p_pointers = &pointers,
-        .on_heap = is_heap_allocated
+        .p_regions = &regions,
+        .p_watches = &watches,
+        .p_watch_pages = NULL, // Nothing is watched until the watch command
+        .p_nursery = NULL, // Every malloc goes to the main memory until nursery_create
+        .p_forks = NULL, // There is one memory until the fork command
+        .fork_slot = 0,
+        .journal = {.p_file = NULL}, // Nothing is journaled until the journal command
+        .backing = backing,
+        .allocator = allocator,
+        .bulk_kernels = select_bulk_kernels(), // The widest loops this CPU can run
+        .next_fit_rover = NO_BLOCK, // Nothing was searched yet
+        .defrag_budget = 0, // Incremental defragmentation is off until the defrag command turns it on
+        .defrag_position = 0,
+        .max_memory_size = 0, // The memory only grows with the grow command until grow_limit turns it on
+        .gc_auto = GC_OFF, // Garbage is only collected by the gc command until gc_auto turns it on
+        .free_bins_bitmap = 0
     };
+    for (int i = 0; i < AMOUNT_OF_SIZE_CLASSES; i++) { // All the bins start empty
+        memory.arr_free_bins[i] = NO_BLOCK;
+        memory.arr_tlsf_sl_bitmaps[i] = 0;
+        for (int j = 0; j < TLSF_SL_COUNT; j++) {
+            memory.arr_tlsf_lists[i][j] = NO_BLOCK;
+        }
+    }
+    block_map_insert(&memory, 0); // The first block starts at index 0
+    free_bins_insert(&memory, 0); // The whole memory starts as one free block
+    if (arr_allocators[allocator].p_init) {
+        arr_allocators[allocator].p_init(&memory); // Like cutting the memory into powers of two for the buddy allocator
+    }
 
     char input[MAX_INPUT_SIZE]; // Input buffer
 
     printlnf("Welcome to the Bytethon terminal. Please enter help to see a list of commands and how they work. For more information look for the documentation in dir /info.\n\n");
+    printlnf("The bulk memory commands (mem_set, mem_copy, mem_move and mem_cmp) and the vector commands (vec_...) run the %s loops of this CPU.\n", arr_bulk_kernels[memory.bulk_kernels].p_name);
     while (1) {
         printf(">>> ");
         fgets(input,sizeof(input),stdin);
         execute_command(&memory,&commands,input); 
+        defrag_step(&memory); // A little of the fragmentation is fixed after every command, if the defrag command turned it on
     }
   return 0;
 }
\ No newline at end of file
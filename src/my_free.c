@@ -4,23 +4,25 @@
 //
 // Input : A pointer to the memory and the amount of arguments and the arguments
 //
-// Output : Calls the function my_free if all the arguments are valid
-void my_free_command(Memory *p_memory, int args_c, char *args[10]) {
+// Output : Calls the function my_free if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status my_free_command(Memory *p_memory, int args_c, char *args[10]) {
     if (args_c != 1) {
         print_error("Wrong amount of arguments for function free. Expected 1 argument but received %d arguments",args_c);
-        return;
+        return COMMAND_FAILED;
     }
     HashMap *p_pointers = p_memory->p_pointers;  // Readability
     Pointer *p_ptr = (Pointer*)hashmap_get(p_pointers, args[0]);
     if (p_ptr == NULL) {
         print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.",args[0]);
-        return;
+        return COMMAND_FAILED;
     }
     uint8_t success = my_free(p_memory, &p_ptr);
     if (success) {
+        pointer_index_remove(p_memory, p_ptr);
         hashmap_remove(p_memory->p_pointers, args[0],1);
         print_success("Freed pointer %s successfully.", args[0]);
     }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
 }
 
 // Free a block that a pointer <**ptr> is pointing at.
@@ -36,59 +38,82 @@ uint8_t my_free(Memory *p_memory,Pointer **pp_ptr) {
         return 0;
     }
 
-    Block *p_blockptr; // Pointer to allocated memory for the new block
     Pointer *p_ptr = *pp_ptr; // Address of of pointer struct in **pp_ptr 
+    if (p_ptr->p_region != NULL && p_ptr->p_region->type == NURSERY) { // Nothing to do, the next minor collection only copies the pointers that are still declared
+        return 1;
+    }
+    if (p_ptr->p_region != NULL) { // Its bytes are in the block of the region, freeing the block would free the whole region
+        print_error("The pointer at address %" PRId64 " was allocated with %s_alloc, it can only be released with %s.", p_ptr->start_index, 
+            arr_region_type_names[p_ptr->p_region->type], arr_region_release_commands[p_ptr->p_region->type]);
+        return 0;
+    }
 
-    // Stores the block's adress in the pointer and also returns index in block array, unless it wasn't found and then it returns -1
-    int index = find_block(p_memory, p_ptr->start_index, &p_blockptr); 
-    if (index == -1){
-        print_error("Could not locate block at index %d (in the byte array)",
+    // Gets the id of the block that starts at the pointer's index, unless it wasn't found and then it returns NO_BLOCK
+    BlockId block = find_block(p_memory, (size_t)p_ptr->start_index); 
+    if (block == NO_BLOCK){
+        print_error("Could not locate block at index %" PRId64 " (in the byte array)",
         p_ptr->start_index); return 0;
     }
     
-    p_blockptr->free = 1;
-    p_blockptr->uninitialized = 1;
+    const Allocator *p_allocator = &arr_allocators[p_memory->allocator]; // The allocator chosen at startup
+    if (p_allocator->p_free) { // The allocator merges in its own way (like buddy blocks that only merge with their buddy)
+        p_allocator->p_free(p_memory, block);
+        return 1;
+    }
+
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    p_table->p_states[block] = BLOCK_FREE;
+    shadow_clear(p_memory->p_shadow, p_table->p_start_indices[block], p_table->p_sizes[block]); // Free bytes hold garbage
+    watch_free(p_memory, p_table->p_start_indices[block], p_table->p_sizes[block]);
+    free_bins_insert(p_memory, block); // Every free block is in a bin, merging takes it out again if needed
     
-    // Store next and prev in separate variables before accessing their members (for merging)
-    Block *p_next_block = p_blockptr->p_next;
-    Block *p_prev_block = p_blockptr->p_prev;
+    // Store next and prev in separate variables before merging (merging changes the links)
+    BlockId next_block = p_table->p_next[block];
+    BlockId prev_block = p_table->p_prev[block];
 
-    if (p_next_block && p_next_block->free) { // If then next block exists and is free merge it with the current block
-        merge_block_right(p_memory, index);
+    if (next_block != NO_BLOCK && (p_table->p_states[next_block] & BLOCK_FREE)) { // If then next block exists and is free merge it with the current block
+        merge_block_right(p_memory, block);
     }
-    if (p_prev_block && p_prev_block->free) { // If then next block exists and is free merge it with the current block
-        merge_block_right(p_memory, index - 1);
+    if (prev_block != NO_BLOCK && (p_table->p_states[prev_block] & BLOCK_FREE)) { // If then previous block exists and is free merge the current block into it
+        merge_block_right(p_memory, prev_block);
     }
 
-    p_memory->amount_of_blocks--;
-
     return 1;
 }
 
 
 
-// Merges block at index <index> with block at index <index>+1, an attempt to reduce fragmentation in a simple manner
+// Merges the block <block> with the block after it in the linked list, an attempt to reduce fragmentation in a simple manner
 //
-// Input : A pointer to the memory and an index to where to merge
+// Input : A pointer to the memory and the id of the block to merge into
 //
-// Output : Block at index <index> eats block at index <index> + 1
-void merge_block_right(Memory *p_memory, unsigned int index){
-    Block *p_block = &p_memory->p_blocks[index]; // Get the current block
-    Block *p_right_block = p_block->p_next; // Get the block it needs to merge with
-    if (!p_right_block) { // If there is no block to merge with, do nothing
+// Output : Block <block> eats the next block, whose slot goes back to the pool
+void merge_block_right(Memory *p_memory, BlockId block){
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    BlockId right_block = p_table->p_next[block]; // Get the block it needs to merge with
+    if (right_block == NO_BLOCK) { // If there is no block to merge with, do nothing
         return;
     }
     
-    Block *second_right_block = p_right_block->p_next;
-    if (second_right_block) { // If there is no successor to right_block, the next line would cause issues 
-        second_right_block->p_prev = p_block;
+    // Both blocks leave their size class bins before their sizes change
+    free_bins_remove(p_memory, block);
+    free_bins_remove(p_memory, right_block);
+
+    BlockId second_right_block = p_table->p_next[right_block];
+    if (second_right_block != NO_BLOCK) { // If there is no successor to right_block, the next line would cause issues 
+        p_table->p_prev[second_right_block] = block;
     }
     
-    p_block->p_next = p_right_block->p_next; // Rechain the list
-    p_block->size += p_right_block->size; // Make the block "eat" the block it merged with
-    p_block->free = 1; // Make sure the block is set to free (non free block should not merge)
-    p_block->uninitialized = 1; // Free blocks are uninitialized
-    p_memory->amount_of_blocks--;
+    block_map_remove(p_memory, right_block); // While it is still linked, so the map can move on to the next block
+    if (p_memory->next_fit_rover == right_block) { // The next fit search can't start from a block that doesn't exist
+        p_memory->next_fit_rover = block;
+    }
+
+    p_table->p_next[block] = second_right_block; // Rechain the list
+    p_table->p_sizes[block] += p_table->p_sizes[right_block]; // Make the block "eat" the block it merged with
+    p_table->p_states[block] = BLOCK_FREE; // Both were free, so their bits in the shadow are already off (non free block should not merge)
+
+    release_block_slot(p_memory, right_block); // The slot of the eaten block can be reused by the next split
 
-    shift_left(p_memory, index + 1); // Pop the block that was merged with the current index.
+    free_bins_insert(p_memory, block); // The merged block goes into the bin for its new size
 }
\ No newline at end of file
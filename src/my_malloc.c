@@ -4,30 +4,35 @@
 //
 // Input : A pointer to the memory and the amount of arguments and the arguments
 //
-// Output : Calls the function my_malloc if all the arguments are valid
-void my_malloc_command(Memory *p_memory, int args_c, char *args[10]) {
+// Output : Calls the function my_malloc if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status my_malloc_command(Memory *p_memory, int args_c, char *args[10]) {
     if (args_c != 2) {
         print_error("Wrong amount of arguments for function malloc. Expected 2 arguments but received %d arguments",args_c);
-        return;
+        return COMMAND_FAILED;
     }
     
     char *endptr;
     long size = strtol(args[0],&endptr,10); // Convert the string argument that user gave to a long based on decimal notation
-     if(*endptr != '\0' || size < 0) { // Invalid input
+     if(*endptr != '\0' || size <= 0) { // Invalid input
         print_error("First argument in malloc must be a positive integer (no decimal point) non zero number <size>");
-        return;
+        return COMMAND_FAILED;
     }
 
     HashMap *p_pointers = p_memory->p_pointers; // Readability
     Pointer *p_ptr = (Pointer*)hashmap_get(p_pointers, args[1]);
     if (p_ptr == NULL) { // Pointer does not exsist
         print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.",args[1]);
-        return;
+        return COMMAND_FAILED;
     }
-    uint8_t success = my_malloc(p_memory, (size_t)size ,p_ptr);
+    uint8_t success = nursery_alloc(p_memory, (size_t)size, p_ptr); // Small allocations are bumped out of the nursery, if there is one
+    if (!success) {
+        success = my_malloc(p_memory, (size_t)size ,p_ptr);
+    }
+    pointer_index_update(p_memory, p_ptr); // Its start changed, so a block that moves finds it (my_malloc is also called with copies, which are not indexed)
     if (success) {
         print_success("Allocated %ld bytes for pointer %s successfully.", size,args[1]);
     }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
 }
 
 // Allocates memory to a block in the memory based on the pointer and size input, 
@@ -35,121 +40,127 @@ void my_malloc_command(Memory *p_memory, int args_c, char *args[10]) {
 //
 // Input : A pointer to the memory, a size of allocation, and a pointer to a pointer struct
 //
-// Output : Tries to allocate <size> bytes in the memory pointer passed, searches for an index to start the allocation based on best-fit algorithm.
+// Output : Tries to allocate <size> bytes in the memory pointer passed, searches for a free block with the allocator chosen at startup.
 // Returns a boolean (0 or 1) based on success/failure
 uint8_t my_malloc(Memory *p_memory, size_t size, Pointer *p_ptr) {
-    
-    if (p_memory->amount_of_blocks > p_memory->memory_size){
-        print_error("Could not allocate memory: all slots are taken."); 
-        return 0;
-    }
-
-    Block *p_blocks = p_memory->p_blocks;
-    int index = -1; // Initialize index to -1 so if the index is not found, the index is invalid
-    unsigned int best_bytes = p_memory->memory_size + 1; // Make sure the initial value of best bytes is worst than any other vaild option in the memory
+    const Allocator *p_allocator = &arr_allocators[p_memory->allocator]; // The allocator chosen at startup
     uint8_t success = 0;
-    for (int i = 0; i < p_memory->amount_of_blocks; i++) { 
-        if (p_blocks[i].free == 0){continue;} // Avoid double allocation
-        if (p_blocks[i].size == size){ // If the size of the block is exactly the size requested, it is the best option
-            success = allocate(p_memory, size, i, p_ptr);
-            return 1;
+
+    if (p_allocator->p_malloc) { // The allocator splits blocks in its own way (like the buddy allocator)
+        success = p_allocator->p_malloc(p_memory, size, p_ptr);
+        if (!success) { // No block found
+            return retry_after_gc(p_memory, size, p_ptr);
+        }
+    } else {
+        BlockId best = p_allocator->p_find(p_memory, size); // One call for the whole search, the loop of every policy is its own function
+        if (best == NO_BLOCK) { // No block found
+            return retry_after_gc(p_memory, size, p_ptr);
         }
-        if (p_blocks[i].size > size && p_blocks[i].size < best_bytes) { // If the current block is better fit use it instead of previous best
-            index = i;
-            best_bytes = p_blocks[i].size;
+
+        success = allocate(p_memory, size, best, p_ptr);
+        if (!success) {
+            print_error("Could not allocate enough memory for size %zu.", size);
+            return 0;
         }
     }
-    if (index == -1) { // No index found
-        return 0;
+    if (success) { // The pointer points at a block of the main memory now, even if it was allocated from a region before
+        p_ptr->size = size;
+        p_ptr->p_region = NULL;
     }
+    return success;
+}
 
-    success = allocate(p_memory, size,(unsigned int)index, p_ptr);
-    if (!success) {
-        print_error("Could not allocate enough memory for size %zu.", size);
-        return 0;
+// Called when my_malloc can't find a free block, collects garbage (if memory->gc_auto turned it on) and tries again
+//
+// Input : A pointer to the memory, a size of allocation, and a pointer to a pointer struct
+//
+// Output : Returns the result of my_malloc after the collection, or of retry_after_grow if nothing was collected
+uint8_t retry_after_gc(Memory *p_memory, size_t size, Pointer *p_ptr) {
+    if (p_memory->gc_auto == GC_OFF) {
+        return retry_after_grow(p_memory, size, p_ptr);
     }
-    return 1;
+    size_t freed_bytes;
+    size_t freed_blocks = collect_garbage(p_memory, p_memory->gc_auto, &freed_bytes);
+    if (freed_blocks == 0) { // Nothing changed, trying again would fail again, so the memory has to grow
+        return retry_after_grow(p_memory, size, p_ptr);
+    }
+    printlnf("Collected %zu unreachable blocks (%zu bytes) to make room for %zu bytes.", freed_blocks, freed_bytes, size);
+    return my_malloc(p_memory, size, p_ptr); // Nothing is left to collect the second time, so this doesn't go deeper
 }
 
-// Does the actual allocation logic, gets a size and index for where to allocate, 
+// Does the actual allocation logic, gets a size and a block for where to allocate, 
 // and a pointer to point to the allocation along with a pointer to a memory struct.
 //
-// Input : A pointer to the memory, a size of allocation, an index for where to start the allocation, and a pointer to a pointer struct
+// Input : A pointer to the memory, a size of allocation, the id of the free block to allocate in, and a pointer to a pointer struct
 //
-// Output : Tries to allocate <size> bytes with pointer struct <*ptr> in the <*memory> pointer where the <index> is the start in the bytes array, 
-// creating a new blocks in the memory blocks array, and returns a boolean (0 or 1) if it succeded or not.
-uint8_t allocate(Memory *p_memory, size_t size, unsigned int index, Pointer *p_ptr) {
-    int byte_index = 0; // Stores the index of the pointer in the bytes array
-
-    for (int i = 0; i < index; i++) { // Get the index where the allocated memory will start in memory the bytes array
-        byte_index += p_memory->p_blocks[i].size; // Sum the size of the blocks up to the relevant block
-    }
-    if (size == p_memory->p_blocks[index].size) { // If the block and the size of allocation are the same then just toggle free off for the blocki
-        p_memory->p_blocks[index].free = 0;
-        p_ptr->start_index = (int)byte_index;
+// Output : Tries to allocate <size> bytes with pointer struct <*ptr> in the <*memory> pointer at the start of the block <block>, 
+// creating a new block in the block table if needed, and returns a boolean (0 or 1) if it succeded or not.
+uint8_t allocate(Memory *p_memory, size_t size, BlockId block, Pointer *p_ptr) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    int64_t byte_index = (int64_t)p_table->p_start_indices[block]; // Stores the index of the pointer in the bytes array (the allocation starts where the block starts)
+    if (size == p_table->p_sizes[block]) { // If the block and the size of allocation are the same then just toggle free off for the block
+        free_bins_remove(p_memory, block); // The block is not free anymore
+        p_table->p_states[block] &= ~BLOCK_FREE;
+        p_ptr->start_index = byte_index;
         return 1;
     }
-    uint8_t success = split_block(p_memory, size, index); // Try to split the block in memory that is needed for the allocation
+    uint8_t success = split_block(p_memory, size, block); // Try to split the block in memory that is needed for the allocation
     if (success) {
-        p_ptr->start_index = (int)byte_index ;
+        p_ptr->start_index = byte_index;
         return 1;
     }
     return 0;
 }
 
-// Helper function for allocate: if there is a free block of size s at index <index> in the blocks array, 
+// Helper function for allocate: if there is a free block of size s with the id <block>, 
 // and input <size> < s, then it splits the block into a free block of size s - <size> and allocated block of size <size>
 //
-// Input : A pointer to the memory, a size of allocation, an index for where to split the block in block array
+// Input : A pointer to the memory, a size of allocation, the id of the block to split in the block table
 //
-// Output : Split the block that is targeted by <index> based on <size> to a free block and an allocated block
-uint8_t split_block(Memory *p_memory, size_t size, unsigned int index) {
+// Output : Split the block <block> based on <size> to a free block and an allocated block
+uint8_t split_block(Memory *p_memory, size_t size, BlockId block) {
     // Makes sure that you can actually split the block.
-    if (index >= p_memory->amount_of_blocks) {
-        print_error("Could not split block at index %u: out of bounds index.", index); 
+    if (block >= p_memory->amount_of_used_slots) {
+        print_error("Could not split block %u: out of bounds id.", block); 
         return 0;
     }
 
-    Block *p_block = &p_memory->p_blocks[index]; // Increase readability
+    BlockTable *p_table = &p_memory->blocks; // Increase readability
     
-    // Try to shift all the memory one slot to the right to make place for the new block
-    uint8_t success = shift_right(p_memory,index + 1); 
-    if(!success) {
-        // TODO add a logger which lets you see all the errors including this one.
+    // Get a slot for the new free block, no other block moves so every link stays valid
+    BlockId new_free = take_block_slot(p_memory);
+    if (new_free == NO_BLOCK) {
+        print_error("Could not allocate memory: all slots are taken."); 
         return 0;
     }
-    Block new_free; // Create a new free block that is the leftover of the previous block
+    free_bins_remove(p_memory, block); // The block's size is about to change, so it leaves its bin
+
+    p_table->p_next_free[new_free] = NO_BLOCK;
+    p_table->p_prev_free[new_free] = NO_BLOCK;
     
-    // Chain the new_free struct to list
-    new_free.p_next = p_block->p_next;
-    new_free.p_prev = p_block;
+    // Chain the new free block to the list
+    p_table->p_next[new_free] = p_table->p_next[block];
+    p_table->p_prev[new_free] = block;
 
     // Move remaining memory to the new block
-    new_free.size = p_block->size - size;
-    p_block->size = size; 
+    p_table->p_sizes[new_free] = p_table->p_sizes[block] - size;
+    p_table->p_sizes[block] = size; 
 
     // Set the index of the start of the free block to be directly after the end of the allocated block
-    new_free.start_index = p_block->start_index + size;
-
-    // Mark the free block as free and the allocated block as taken
-    new_free.free = 1;
-    p_block->free = 0;
+    p_table->p_start_indices[new_free] = p_table->p_start_indices[block] + size;
 
-    // All blocks start unintialized
-    new_free.uninitialized = 1;
-    p_block->uninitialized = 1;
-
-    // Put the new free block in the array
-    p_memory->p_blocks[index + 1] = new_free;
+    // The free block is free and the allocated block is taken, both hold garbage (the bits of free bytes in the shadow are off)
+    p_table->p_states[new_free] = BLOCK_FREE;
+    p_table->p_states[block] = 0;
 
     // Finish chaining by making the block before and after the new free block recognize the block
-    p_block->p_next = &p_memory->p_blocks[index + 1];
-    
-    Block *p_next_block_after_new_free = p_memory->p_blocks[index + 1].p_next;
-    if (p_next_block_after_new_free) { // If there is a block after the new_free block
-        p_next_block_after_new_free->p_prev = &p_memory->p_blocks[index + 1]; // Chain it too
+    p_table->p_next[block] = new_free;
+    BlockId after_new_free = p_table->p_next[new_free];
+    if (after_new_free != NO_BLOCK) { // If there is a block after the new free block
+        p_table->p_prev[after_new_free] = new_free; // Chain it too
     }
-    // Amount of blocks cannot exceed the size of the memory bytes array
-    p_memory->amount_of_blocks = (p_memory->amount_of_blocks + 1) <p_memory->memory_size ? p_memory->amount_of_blocks + 1 :p_memory->memory_size; 
+
+    block_map_insert(p_memory, new_free); // So find_block can find the new block
+    free_bins_insert(p_memory, new_free); // The leftover is free, so it goes into its size class bin
     return 1;
 }
@@ -0,0 +1,171 @@
+#include "my_realloc.h"
+
+// Arguments parser for the my_realloc function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function my_realloc if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status my_realloc_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 2) {
+        print_error("Wrong amount of arguments for function realloc. Expected 2 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    long size = strtol(args[0],&endptr,10); // Convert the string argument that user gave to a long based on decimal notation
+    if(*endptr != '\0' || size <= 0) { // Invalid input
+        print_error("First argument in realloc must be a positive integer (no decimal point) non zero number <size>");
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_ptr = (Pointer*)hashmap_get(p_memory->p_pointers, args[1]);
+    if (p_ptr == NULL) { // Pointer does not exsist
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.",args[1]);
+        return COMMAND_FAILED;
+    }
+    uint8_t success = my_realloc(p_memory, (size_t)size, p_ptr);
+    pointer_index_update(p_memory, p_ptr); // Even if it failed, it could have been promoted out of the nursery first
+    if (success) {
+        print_success("Reallocated pointer %s to %ld bytes successfully.", args[1], size);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Changes the size of the block a pointer points at, in place when it can, and keeps the bytes that were in it
+//
+// Input : A pointer to the memory, the new size of the allocation, and a pointer to a pointer struct
+//
+// Output : Shrinks the block by splitting off a free tail, or grows it into the free block after it,
+// and only if neither is possible allocates a new block, copies the bytes to it and frees the old block.
+// Returns a boolean (0 or 1) if it succeded or not
+uint8_t my_realloc(Memory *p_memory, size_t new_size, Pointer *p_ptr) {
+    if (p_ptr->p_region != NULL && p_ptr->p_region->type == NURSERY && !promote_pointer(p_memory, p_ptr)) { // Its own block can grow and shrink
+        print_error("Could not find a free block of %zu bytes to move the pointer out of the nursery.", p_ptr->size);
+        return 0;
+    }
+    if (p_ptr->p_region != NULL) { // The region hands out its own bytes, its block can't change size for one pointer
+        print_error("The pointer at address %" PRId64 " was allocated with %s_alloc, it can't be reallocated.", p_ptr->start_index, arr_region_type_names[p_ptr->p_region->type]);
+        return 0;
+    }
+    if (p_ptr->start_index < 0) { // Nothing to keep, same as malloc (like realloc(NULL, size) in C)
+        if (!my_malloc(p_memory, new_size, p_ptr)) {
+            print_error("Could not find a free block of %zu bytes.", new_size);
+            return 0;
+        }
+        return 1;
+    }
+
+    BlockId block = find_block(p_memory, (size_t)p_ptr->start_index);
+    if (block == NO_BLOCK) {
+        print_error("Could not locate block at index %" PRId64 " (in the byte array)", p_ptr->start_index);
+        return 0;
+    }
+
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    size_t old_size = p_table->p_sizes[block];
+    uint8_t in_place = 0;
+    if (arr_allocators[p_memory->allocator].p_malloc) { // The allocator splits in its own way (buddy blocks are powers of two)
+        in_place = new_size <= old_size && new_size * 2 > old_size; // The block is still the smallest one that fits
+    } else if (new_size == old_size) {
+        in_place = 1;
+    } else if (new_size < old_size) {
+        in_place = shrink_block(p_memory, block, new_size);
+    } else {
+        in_place = grow_block(p_memory, block, new_size);
+    }
+    if (in_place) {
+        p_ptr->size = new_size;
+        return 1;
+    }
+
+    // Allocate, copy, free. The new block is allocated before the old one is freed, so they never overlap
+    Pointer old_ptr = *p_ptr;
+    Pointer *p_old_ptr = &old_ptr; // my_free takes a pointer to a pointer
+    if (!my_malloc(p_memory, new_size, p_ptr)) {
+        print_error("Could not find a free block of %zu bytes to move the pointer to.", new_size);
+        return 0;
+    }
+    size_t bytes_to_copy = (new_size < old_size) ? new_size : old_size;
+    memmove(p_memory->p_bytes + p_ptr->start_index, p_memory->p_bytes + old_ptr.start_index, bytes_to_copy);
+
+    // The copied bytes are as written as they were in the old block
+    shadow_copy(p_memory->p_shadow, (size_t)p_ptr->start_index, p_memory->p_shadow, (size_t)old_ptr.start_index, bytes_to_copy);
+    watch_move(p_memory, (size_t)old_ptr.start_index, (size_t)p_ptr->start_index, bytes_to_copy); // Before the old block is freed, so they are not removed
+    watch_write(p_memory, (size_t)p_ptr->start_index, bytes_to_copy, "realloc");
+    return my_free(p_memory, &p_old_ptr);
+}
+
+// Splits the end of an allocated block off into a free block, and merges it with the free block after it if there is one
+//
+// Input : A pointer to the memory, the id of an allocated block and its new size (less than its size)
+//
+// Output : The block has <new_size> bytes (and keeps its state), the bytes after them are free. 
+// Returns a boolean (0 or 1) if it succeded or not
+uint8_t shrink_block(Memory *p_memory, BlockId block, size_t new_size) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    BlockId tail = take_block_slot(p_memory);
+    if (tail == NO_BLOCK) {
+        return 0;
+    }
+
+    // Chain the tail right after the block, like split_block (which only splits free blocks)
+    BlockId next = p_table->p_next[block];
+    p_table->p_next[tail] = next;
+    p_table->p_prev[tail] = block;
+    p_table->p_next[block] = tail;
+    if (next != NO_BLOCK) {
+        p_table->p_prev[next] = tail;
+    }
+    p_table->p_sizes[tail] = p_table->p_sizes[block] - new_size;
+    p_table->p_start_indices[tail] = p_table->p_start_indices[block] + new_size;
+    p_table->p_states[tail] = BLOCK_FREE;
+    shadow_clear(p_memory->p_shadow, p_table->p_start_indices[tail], p_table->p_sizes[tail]); // The bytes that were cut off hold garbage now
+    watch_free(p_memory, p_table->p_start_indices[tail], p_table->p_sizes[tail]);
+    p_table->p_sizes[block] = new_size;
+
+    block_map_insert(p_memory, tail);
+    free_bins_insert(p_memory, tail);
+    if (next != NO_BLOCK && (p_table->p_states[next] & BLOCK_FREE)) { // Two free blocks can't be next to each other
+        merge_block_right(p_memory, tail);
+    }
+    return 1;
+}
+
+// Grows an allocated block into the free block after it
+//
+// Input : A pointer to the memory, the id of an allocated block and its new size (more than its size)
+//
+// Output : Returns 1 if the block has <new_size> bytes now (what is left of the free block stays free), 
+// or 0 if the block after it is not free or not big enough
+uint8_t grow_block(Memory *p_memory, BlockId block, size_t new_size) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    BlockId next = p_table->p_next[block];
+    if (next == NO_BLOCK || !(p_table->p_states[next] & BLOCK_FREE)) {
+        return 0;
+    }
+    size_t extra = new_size - p_table->p_sizes[block]; // How many bytes to take from the free block
+    if (extra > p_table->p_sizes[next]) {
+        return 0;
+    }
+
+    free_bins_remove(p_memory, next); // Before its size changes
+    block_map_remove(p_memory, next); // Its start changes (or it goes away), it is put back below
+    if (extra == p_table->p_sizes[next]) { // The whole free block is eaten
+        BlockId after_next = p_table->p_next[next];
+        p_table->p_next[block] = after_next;
+        if (after_next != NO_BLOCK) {
+            p_table->p_prev[after_next] = block;
+        }
+        if (p_memory->next_fit_rover == next) { // The next fit search can't start from a block that doesn't exist
+            p_memory->next_fit_rover = block;
+        }
+        release_block_slot(p_memory, next);
+    } else { // The free block starts later and is smaller
+        p_table->p_start_indices[next] += extra;
+        p_table->p_sizes[next] -= extra;
+        block_map_insert(p_memory, next);
+        free_bins_insert(p_memory, next);
+    }
+    p_table->p_sizes[block] = new_size;
+    return 1;
+}
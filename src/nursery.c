@@ -0,0 +1,173 @@
+#include "nursery.h"
+
+// Arguments parser for the nursery_create function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function nursery_create if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status nursery_create_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 2) {
+        print_error("Wrong amount of arguments for function nursery_create. Expected 2 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    long size = strtol(args[0],&endptr,10); // Convert the string argument that user gave to a long based on decimal notation
+    if(*endptr != '\0' || size <= 0) { // Invalid input
+        print_error("First argument in nursery_create must be a positive integer (no decimal point) non zero number <size>");
+        return COMMAND_FAILED;
+    }
+
+    long max_object_size = strtol(args[1],&endptr,10);
+    if(*endptr != '\0' || max_object_size <= 0 || max_object_size > size) { // Invalid input
+        print_error("Second argument in nursery_create must be a positive integer (no decimal point) that is at most the size of the nursery <max object size>");
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = nursery_create(p_memory, (size_t)size, (size_t)max_object_size);
+    if (success) {
+        print_success("Created a nursery of %ld bytes for allocations of up to %ld bytes successfully.", size, max_object_size);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Creates the nursery, a region that the malloc command hands small allocations out of (bump pointer, like an arena),
+// so blocks that die young never split the main memory
+//
+// Input : A pointer to the memory, the size of the nursery in bytes and the biggest allocation it hands out
+//
+// Output : Carves one block of <size> bytes from the memory for the nursery and saves it in memory->p_nursery,
+// returns a boolean (0 or 1) if it succeded or not
+uint8_t nursery_create(Memory *p_memory, size_t size, size_t max_object_size) {
+    if (p_memory->p_nursery != NULL) { // my_malloc_command only looks at one nursery
+        print_error("There already is a nursery of %zu bytes.", p_memory->blocks.p_sizes[p_memory->p_nursery->block]);
+        return 0;
+    }
+
+    Region *p_nursery = create_region(p_memory, NURSERY_NAME, NURSERY, size);
+    if (p_nursery == NULL) {
+        return 0;
+    }
+    p_nursery->object_size = (uint32_t)max_object_size;
+    p_memory->p_nursery = p_nursery;
+    return 1;
+}
+
+// Allocates <size> bytes from the nursery, and runs a minor collection first if the nursery is full
+//
+// Input : A pointer to the memory, the size of the allocation, and a pointer to a pointer struct
+//
+// Output : Points <*p_ptr> at the next <size> bytes of the nursery and returns 1, or returns 0 if there is no nursery,
+// the allocation is too big for it, or there is still no room after the collection (then the caller allocates from the main memory)
+uint8_t nursery_alloc(Memory *p_memory, size_t size, Pointer *p_ptr) {
+    Region *p_nursery = p_memory->p_nursery; // Readability
+    if (p_nursery == NULL || size > p_nursery->object_size) { // Big allocations usually live long, they go to the main memory
+        return 0;
+    }
+
+    size_t nursery_size = p_memory->blocks.p_sizes[p_nursery->block];
+    if (size > nursery_size - p_nursery->used) { // Full, move the survivors out and start again from the start
+        size_t promoted, promoted_bytes;
+        if (!minor_collect(p_memory, &promoted, &promoted_bytes)) {
+            return 0;
+        }
+        printlnf("Promoted %zu surviving pointers (%zu bytes) out of the nursery to make room for %zu bytes.", promoted, promoted_bytes, size);
+    }
+
+    p_ptr->start_index = (int64_t)(p_memory->blocks.p_start_indices[p_nursery->block] + p_nursery->used);
+    p_ptr->size = size;
+    p_ptr->p_region = p_nursery;
+    p_ptr->generation = p_nursery->generation; // Valid until the next minor collection, which promotes it first
+    p_nursery->used += size;
+    return 1;
+}
+
+// Arguments parser for the minor_collect function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function minor_collect if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status nursery_collect_command(Memory *p_memory, int args_c, char *args[10]) {
+    (void)args; // No arguments
+    if (args_c != 0) {
+        print_error("Wrong amount of arguments for function nursery_collect. Expected 0 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+    if (p_memory->p_nursery == NULL) {
+        print_error("There is no nursery. Please create it with the command nursery_create.");
+        return COMMAND_FAILED;
+    }
+
+    size_t promoted, promoted_bytes;
+    uint8_t success = minor_collect(p_memory, &promoted, &promoted_bytes);
+    if (success) {
+        print_success("Promoted %zu surviving pointers (%zu bytes) out of the nursery successfully.", promoted, promoted_bytes);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Empties the nursery, every pointer that still points into it survived and is promoted (copied) to a block of the main memory
+//
+// Input : A pointer to the memory, and where to put how many pointers and bytes were promoted
+//
+// Output : Returns 1 after resetting the nursery, or 0 (after printing an error) if a survivor didn't fit in the main memory,
+// then the survivors that were not promoted yet stay in the nursery and it is not reset
+uint8_t minor_collect(Memory *p_memory, size_t *p_promoted, size_t *p_promoted_bytes) {
+    Region *p_nursery = p_memory->p_nursery; // Readability
+    HashMap *p_pointers = p_memory->p_pointers;
+    *p_promoted = 0;
+    *p_promoted_bytes = 0;
+
+    // Freed pointers were removed from the hashmap, so every pointer into the nursery that is left is a survivor
+    for (size_t i = 0; i < p_pointers->bucket_size; i++) {
+        for (HashNode *p_node = p_pointers->pp_map[i]; p_node != NULL; p_node = p_node->p_next) {
+            Pointer *p_ptr = (Pointer*)p_node->p_value;
+            if (p_ptr->p_region != p_nursery || p_ptr->generation != p_nursery->generation) {
+                continue;
+            }
+            if (!promote_pointer(p_memory, p_ptr)) {
+                print_error("Could not promote pointer %s out of the nursery, the main memory has no free block of %zu bytes.", p_node->p_key, p_ptr->size);
+                return 0;
+            }
+            pointer_index_update(p_memory, p_ptr); // Its start changed, so a block that moves finds it
+            (*p_promoted)++;
+            *p_promoted_bytes += p_ptr->size;
+        }
+    }
+
+    // Same as arena_reset, the pointers that were not promoted are invalid now
+    shadow_clear(p_memory->p_shadow, p_memory->blocks.p_start_indices[p_nursery->block], p_nursery->used);
+    watch_free(p_memory, p_memory->blocks.p_start_indices[p_nursery->block], p_nursery->used); // The promoted ones moved out already
+    p_nursery->used = 0;
+    p_nursery->generation++;
+    return 1;
+}
+
+// Moves the bytes of a pointer from the nursery to a new block of the main memory
+//
+// Input : A pointer to the memory and a pointer to a pointer struct that points into the nursery
+//
+// Output : Allocates a block of the size of the pointer with my_malloc, copies the bytes to it and points <*p_ptr> at it,
+// returns a boolean (0 or 1) if it succeded or not (then <*p_ptr> still points into the nursery)
+uint8_t promote_pointer(Memory *p_memory, Pointer *p_ptr) {
+    size_t start, size;
+    BlockId nursery_block = resolve_pointer(p_memory, *p_ptr, &start, &size);
+    if (nursery_block == NO_BLOCK) {
+        return 0;
+    }
+
+    Pointer promoted = {0};
+    if (!my_malloc(p_memory, size, &promoted)) {
+        return 0;
+    }
+    memcpy(p_memory->p_bytes + promoted.start_index, p_memory->p_bytes + start, size); // Different blocks, so they can't overlap
+    shadow_copy(p_memory->p_shadow, (size_t)promoted.start_index, p_memory->p_shadow, start, size); // As written as it was in the nursery
+    watch_move(p_memory, start, (size_t)promoted.start_index, size);
+
+    // Field by field, the links of the pointer index in <*p_ptr> stay (the caller files it under its new start)
+    p_ptr->start_index = promoted.start_index;
+    p_ptr->size = promoted.size;
+    p_ptr->p_region = promoted.p_region;
+    p_ptr->generation = promoted.generation;
+    return 1;
+}
@@ -0,0 +1,131 @@
+#define _GNU_SOURCE // For mremap(), before any header includes the system headers
+#include "pages.h"
+
+#ifdef __linux__
+#include <sys/mman.h> // For mmap(), madvise() and munmap()
+#include <sys/stat.h> // For fstat(), to get the size of a file
+#include <fcntl.h> // For open()
+#include <unistd.h> // For close()
+#endif
+
+// Reserves address space for an array with mmap, without committing memory for it (Linux only).
+// The kernel gives a page real memory (zeroed) only when it is first used, so reserving is O(1) in time no matter the size
+//
+// Input : The size of the array in bytes, and a boolean (0 or 1) for asking for transparent huge pages
+//
+// Output : Returns a pointer to the start of the reserved pages, or NULL if mmap failed (or on systems without mmap)
+void* reserve_pages(size_t size, uint8_t huge_pages) {
+#ifdef __linux__
+    // MAP_NORESERVE so the whole size doesn't count against the commit limit, only the pages that are used do
+    void *p_pages = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p_pages == MAP_FAILED) {
+        return NULL;
+    }
+#ifdef MADV_HUGEPAGE
+    if (huge_pages) { // Only a hint, if transparent huge pages are turned off in the kernel the pages stay 4 KB
+        madvise(p_pages, size, MADV_HUGEPAGE);
+    }
+#endif
+    return p_pages;
+#else
+    (void)size;
+    (void)huge_pages;
+    return NULL;
+#endif
+}
+
+// Resizes pages that reserve_pages reserved, the kernel moves them to a new address (without copying the bytes) if they can't grow where they are
+//
+// Input : A pointer that reserve_pages (or resize_pages) returned, the size it was called with and the new size
+//
+// Output : Returns a pointer to the resized pages (the new pages are zeroed), or NULL if mremap failed (or on systems without mremap)
+void* resize_pages(void *p_pages, size_t old_size, size_t new_size) {
+#ifdef __linux__
+    void *p_resized = mremap(p_pages, old_size, new_size, MREMAP_MAYMOVE);
+    if (p_resized == MAP_FAILED) {
+        return NULL;
+    }
+    return p_resized;
+#else
+    (void)p_pages;
+    (void)old_size;
+    (void)new_size;
+    return NULL;
+#endif
+}
+
+// Gives pages that reserve_pages reserved back to the system
+//
+// Input : A pointer that reserve_pages returned and the size it was called with
+//
+// Output : Unmaps the pages, does nothing for NULL
+void release_pages(void *p_pages, size_t size) {
+#ifdef __linux__
+    if (p_pages != NULL) {
+        munmap(p_pages, size);
+    }
+#else
+    (void)p_pages;
+    (void)size;
+#endif
+}
+
+// Maps a whole file into memory to read it, without copying it into a buffer (Linux only, other systems read it into a malloc buffer)
+//
+// Input : The path of the file and where to put its size
+//
+// Output : Returns a pointer to the (read only) bytes of the file and puts its size in *p_size, or NULL if it couldn't be opened (or is empty)
+const uint8_t* map_file(const char *path, size_t *p_size) {
+#ifdef __linux__
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+    void *p_file = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file open
+    if (p_file == MAP_FAILED) {
+        return NULL;
+    }
+    madvise(p_file, (size_t)file_stat.st_size, MADV_SEQUENTIAL); // Read once from start to end, so the kernel can read ahead
+    *p_size = (size_t)file_stat.st_size;
+    return (const uint8_t*)p_file;
+#else
+    FILE *p_stream = fopen(path, "rb");
+    if (p_stream == NULL) {
+        return NULL;
+    }
+    fseek(p_stream, 0, SEEK_END);
+    long size = ftell(p_stream);
+    fseek(p_stream, 0, SEEK_SET);
+    uint8_t *p_file = (size > 0) ? malloc((size_t)size) : NULL;
+    if (p_file != NULL && fread(p_file, 1, (size_t)size, p_stream) != (size_t)size) {
+        free(p_file);
+        p_file = NULL;
+    }
+    fclose(p_stream);
+    *p_size = (size_t)size;
+    return p_file;
+#endif
+}
+
+// Gives back a file that map_file mapped
+//
+// Input : A pointer that map_file returned and the size it put in *p_size
+//
+// Output : Unmaps (or frees) the bytes, does nothing for NULL
+void unmap_file(const uint8_t *p_file, size_t size) {
+    if (p_file == NULL) {
+        return;
+    }
+#ifdef __linux__
+    munmap((void*)p_file, size);
+#else
+    (void)size;
+    free((void*)p_file);
+#endif
+}
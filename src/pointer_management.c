@@ -4,11 +4,11 @@
 //
 // Input : A pointer to the memory and the amount of arguments and the arguments
 //
-// Output : Calls the function new_pointer if all the arguments are valid
-void new_pointer_command(Memory *p_memory, int args_c, char *args[10]) {
+// Output : Calls the function new_pointer if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status new_pointer_command(Memory *p_memory, int args_c, char *args[10]) {
     if (args_c != 1) {
         print_error("Wrong amount of arguments for function new_pointer. Expected 1 argument but received %d arguments",args_c);
-        return;
+        return COMMAND_FAILED;
     }
 
     HashMap *p_pointers = p_memory->p_pointers; // Readability
@@ -18,26 +18,143 @@ void new_pointer_command(Memory *p_memory, int args_c, char *args[10]) {
         
         if (!conf) {
             printlnf("Keeping previous pointer.");
-            return;
+            return COMMAND_CANCELED;
         }
         printlnf("Proceeding...");
     }
-    new_pointer(p_pointers, name);
+    new_pointer(p_memory, name);
+    return COMMAND_SUCCEEDED;
 }
 
 // Creates a new pointer struct and adds it into the pointer struct hashmap in the memory struct
 //
-// Input : A pointer to a pointer struct hashmap (Usually inside a memory struct) and a name for the new pointer
+// Input : A pointer to the memory and a name for the new pointer
 //
-// Output : Initializes a new pointer struct into the pointer struct map
-void new_pointer(HashMap *p_pointer_map, char *name) {
+// Output : Initializes a new pointer struct into memory->p_pointers (replacing the pointer with the same name, if there is one)
+void new_pointer(Memory *p_memory, char *name) {
     Pointer *p_ptr = malloc(sizeof(Pointer)); // Put the new pointer on the heap (so it can be used in the hashmap)
     
     if(!p_ptr) {
         fprintf(stderr, "Memory allocation failed for Command struct!\n");
         exit(1);
     }
+    *p_ptr = (Pointer){.start_index = -1, .size = 0, .p_region = NULL, .generation = 0}; // Not pointing at anything yet
 
-    hashmap_insert(p_pointer_map, name, p_ptr, (uint8_t)1); //  Insert heap-allocated pointer, don't print warnings
+    Pointer *p_old_ptr = (Pointer*)hashmap_get(p_memory->p_pointers, name);
+    if (p_old_ptr != NULL) { // hashmap_insert frees it, so it can't stay in the pointer index
+        pointer_index_remove(p_memory, p_old_ptr);
+    }
+    hashmap_insert(p_memory->p_pointers, name, p_ptr, (uint8_t)1); //  Insert heap-allocated pointer, don't print warnings
     print_success("Declared pointer %s successfully.", name);
-}
\ No newline at end of file
+}
+// Finds the bytes that a pointer points at, in the main memory or in a region
+//
+// Input : A pointer to the memory, a pointer struct, and pointers to where to put the start and the size of what it points at
+//
+// Output : Puts the start index and the size in *p_start and *p_size, and returns the id of the block that holds them 
+// (the region's block for pointers from a region), or returns NO_BLOCK (after printing an error) if the pointer is not valid
+BlockId resolve_pointer(Memory *p_memory, Pointer ptr, size_t *p_start, size_t *p_size) {
+    if (ptr.p_region != NULL) { // The region knows where its block is, and the pointer knows its own size
+        if (ptr.generation != ptr.p_region->generation) {
+            print_error("The pointer at address %" PRId64 " was released when its %s was reset.", ptr.start_index, arr_region_type_names[ptr.p_region->type]);
+            return NO_BLOCK;
+        }
+        *p_start = (size_t)ptr.start_index;
+        *p_size = ptr.size;
+        return ptr.p_region->block;
+    }
+
+    BlockId block = find_block(p_memory, (size_t)ptr.start_index);
+    if (block == NO_BLOCK) {
+        print_error("Could not find allocated block at address %" PRId64, ptr.start_index); // If the index was not found print an error message
+        return NO_BLOCK;
+    }
+    *p_start = (size_t)ptr.start_index;
+    *p_size = p_memory->blocks.p_sizes[block]; // The whole block, which can be bigger than the size that was requested
+    return block;
+}
+
+// Files a pointer of memory->p_pointers under the page its start is in, or takes it out of the index if it doesn't point anywhere.
+// Called after every change to the start of a pointer of memory->p_pointers, so a moved block finds its pointers (see pointer_index_move)
+//
+// Input : A pointer to the memory and a pointer struct of memory->p_pointers (not a copy, the lists link the structs themselves)
+//
+// Output : The pointer is in the list of the page of its start_index (moved there if it was in the list of another page),
+// or in no list if start_index is -1
+void pointer_index_update(Memory *p_memory, Pointer *p_ptr) {
+    if (p_ptr->is_indexed && p_ptr->start_index >= 0 && p_ptr->indexed_page == (size_t)p_ptr->start_index / POINTER_INDEX_PAGE_SIZE) {
+        return; // Still in the right list
+    }
+    pointer_index_remove(p_memory, p_ptr);
+    if (p_ptr->start_index < 0) { // Not allocated, so there is nothing to move it with
+        return;
+    }
+
+    // Push to the head of the list of its page
+    size_t page = (size_t)p_ptr->start_index / POINTER_INDEX_PAGE_SIZE;
+    Pointer *p_old_head = p_memory->pp_pointer_index[page];
+    p_ptr->p_prev_indexed = NULL;
+    p_ptr->p_next_indexed = p_old_head;
+    if (p_old_head != NULL) {
+        p_old_head->p_prev_indexed = p_ptr;
+    }
+    p_memory->pp_pointer_index[page] = p_ptr;
+    p_ptr->indexed_page = page;
+    p_ptr->is_indexed = 1;
+}
+
+// Takes a pointer out of the pointer index, before it is removed from memory->p_pointers (and freed)
+//
+// Input : A pointer to the memory and a pointer struct of memory->p_pointers
+//
+// Output : The pointer is in no list of memory->pp_pointer_index, does nothing if it wasn't in one
+void pointer_index_remove(Memory *p_memory, Pointer *p_ptr) {
+    if (!p_ptr->is_indexed) {
+        return;
+    }
+    if (p_ptr->p_prev_indexed != NULL) {
+        p_ptr->p_prev_indexed->p_next_indexed = p_ptr->p_next_indexed;
+    } else { // The head of its list
+        p_memory->pp_pointer_index[p_ptr->indexed_page] = p_ptr->p_next_indexed;
+    }
+    if (p_ptr->p_next_indexed != NULL) {
+        p_ptr->p_next_indexed->p_prev_indexed = p_ptr->p_prev_indexed;
+    }
+    p_ptr->is_indexed = 0;
+}
+
+// Moves the pointers into bytes that were moved, with the pointer index instead of a walk over memory->p_pointers
+//
+// Input : A pointer to the memory, where the bytes started, where they start now and how many there are
+//
+// Output : Every pointer of memory->p_pointers that started in the old bytes keeps its offset inside them, at their new start.
+// Only checks the pointers in the pages of the old bytes
+void pointer_index_move(Memory *p_memory, size_t old_start, size_t new_start, size_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    // The pointers are taken out of their lists first and filed again after, so one that moves into a page that wasn't checked yet isn't moved twice
+    Pointer *p_moved = NULL; // Chained through p_next_indexed
+    size_t last_page = (old_start + size - 1) / POINTER_INDEX_PAGE_SIZE;
+    for (size_t page = old_start / POINTER_INDEX_PAGE_SIZE; page <= last_page; page++) {
+        Pointer *p_ptr = p_memory->pp_pointer_index[page];
+        while (p_ptr != NULL) {
+            Pointer *p_next = p_ptr->p_next_indexed; // Before it is taken out
+            size_t start = (size_t)p_ptr->start_index;
+            if (start >= old_start && start - old_start < size) {
+                pointer_index_remove(p_memory, p_ptr);
+                p_ptr->p_next_indexed = p_moved;
+                p_moved = p_ptr;
+            }
+            p_ptr = p_next;
+        }
+    }
+
+    while (p_moved != NULL) {
+        Pointer *p_next = p_moved->p_next_indexed; // Before pointer_index_update links it into a list
+        p_moved->start_index = (int64_t)(new_start + ((size_t)p_moved->start_index - old_start));
+        pointer_index_update(p_memory, p_moved);
+        p_moved = p_next;
+    }
+}
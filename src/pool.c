@@ -0,0 +1,180 @@
+#include "pool.h"
+
+// Arguments parser for the pool_create function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function pool_create if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status pool_create_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 3) {
+        print_error("Wrong amount of arguments for function pool_create. Expected 3 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    long object_size = strtol(args[1],&endptr,10); // Convert the string argument that user gave to a long based on decimal notation
+    if(*endptr != '\0' || object_size <= 0) { // Invalid input
+        print_error("Second argument in pool_create must be a positive integer (no decimal point) non zero number <object_size>");
+        return COMMAND_FAILED;
+    }
+
+    long count = strtol(args[2],&endptr,10);
+    if(*endptr != '\0' || count <= 0) { // Invalid input
+        print_error("Third argument in pool_create must be a positive integer (no decimal point) non zero number <count>");
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = pool_create(p_memory, args[0], (size_t)object_size, (size_t)count);
+    if (success) {
+        print_success("Created pool %s with %ld objects of %ld bytes successfully.", args[0], count, object_size);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Creates a pool, a region that is split into <count> objects of <object_size> bytes (a slab)
+//
+// Input : A pointer to the memory, a name for the pool, the size of every object and the amount of objects
+//
+// Output : Carves one block of <object_size> * <count> bytes from the memory for the pool and links all the objects into its free list, 
+// returns a boolean (0 or 1) if it succeded or not
+uint8_t pool_create(Memory *p_memory, char *name, size_t object_size, size_t count) {
+    if (object_size < POOL_MIN_OBJECT_SIZE) { // The free list is kept inside the free objects
+        print_error("Objects of a pool must be at least %zu bytes.", POOL_MIN_OBJECT_SIZE);
+        return 0;
+    }
+    if (object_size > UINT32_MAX || count > POOL_END_OF_LIST) { // Region.object_size and Region.count are 32 bits, like the links of the free list
+        print_error("A pool can have objects of up to %" PRIu32 " bytes and up to %" PRIu32 " objects.", UINT32_MAX, (uint32_t)POOL_END_OF_LIST);
+        return 0;
+    }
+    if (count > p_memory->memory_size / object_size) { // Also makes sure object_size * count doesn't overflow
+        print_error("A pool of %zu objects of %zu bytes is bigger than the memory.", count, object_size);
+        return 0;
+    }
+
+    Region *p_pool = create_region(p_memory, name, POOL, object_size * count);
+    if (p_pool == NULL) {
+        return 0;
+    }
+    p_pool->object_size = (uint32_t)object_size;
+    p_pool->count = (uint32_t)count;
+    p_pool->free_head = 0;
+
+    // Every free object holds the index of the next free object in its first bytes, so the objects need no metadata
+    uint8_t *p_slab = p_memory->p_bytes + p_memory->blocks.p_start_indices[p_pool->block];
+    for (uint32_t i = 0; i < p_pool->count; i++) {
+        uint32_t next = (i + 1 < p_pool->count) ? i + 1 : POOL_END_OF_LIST;
+        memcpy(p_slab + (size_t)i * object_size, &next, sizeof(next)); // memcpy since the objects don't have to be aligned
+    }
+    watch_write(p_memory, p_memory->blocks.p_start_indices[p_pool->block], object_size * count, "pool_create");
+    return 1;
+}
+
+// Arguments parser for the pool_alloc function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function pool_alloc if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status pool_alloc_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 2) {
+        print_error("Wrong amount of arguments for function pool_alloc. Expected 2 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    Region *p_pool = get_region(p_memory, args[0], POOL);
+    if (p_pool == NULL) {
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_ptr = (Pointer*)hashmap_get(p_memory->p_pointers, args[1]);
+    if (p_ptr == NULL) { // Pointer does not exsist
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.",args[1]);
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = pool_alloc(p_memory, p_pool, p_ptr);
+    pointer_index_update(p_memory, p_ptr); // Its start changed, so a block that moves finds it
+    if (success) {
+        print_success("Allocated an object of %u bytes from pool %s for pointer %s successfully.", p_pool->object_size, args[0], args[1]);
+    } else {
+        print_error("All %u objects of pool %s are allocated.", p_pool->count, args[0]);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Allocates one object from a pool by popping the head of its free list, in O(1)
+//
+// Input : A pointer to the memory, a pointer to the pool and a pointer to a pointer struct
+//
+// Output : Points <*p_ptr> at a free object of the pool and returns 1, or returns 0 if every object of the pool is allocated
+uint8_t pool_alloc(Memory *p_memory, Region *p_pool, Pointer *p_ptr) {
+    if (p_pool->free_head == POOL_END_OF_LIST) { // No free objects
+        return 0;
+    }
+
+    size_t start = p_memory->blocks.p_start_indices[p_pool->block] + (size_t)p_pool->free_head * p_pool->object_size;
+    memcpy(&p_pool->free_head, p_memory->p_bytes + start, sizeof(p_pool->free_head)); // The next free object is the new head
+
+    p_ptr->start_index = (int64_t)start;
+    p_ptr->size = p_pool->object_size;
+    p_ptr->p_region = p_pool;
+    p_ptr->generation = p_pool->generation;
+    p_pool->used++;
+    return 1;
+}
+
+// Arguments parser for the pool_free function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function pool_free if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status pool_free_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function pool_free. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_ptr = (Pointer*)hashmap_get(p_memory->p_pointers, args[0]);
+    if (p_ptr == NULL) { // Pointer does not exsist
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.",args[0]);
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = pool_free(p_memory, p_ptr);
+    if (success) {
+        pointer_index_remove(p_memory, p_ptr);
+        hashmap_remove(p_memory->p_pointers, args[0],1); // Same as free, the pointer is gone so its object can't be freed twice
+        print_success("Freed pointer %s back to its pool successfully.", args[0]);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Releases one object of a pool by pushing it to the head of the free list of the pool, in O(1)
+//
+// Input : A pointer to the memory and a pointer to a pointer struct that was allocated with pool_alloc
+//
+// Output : The object of the pointer can be allocated again, returns a boolean (0 or 1) if it succeded or not
+uint8_t pool_free(Memory *p_memory, Pointer *p_ptr) {
+    Region *p_pool = p_ptr->p_region; // Readability
+    if (p_pool == NULL || p_pool->type != POOL) {
+        print_error("The pointer at address %" PRId64 " was not allocated with pool_alloc.", p_ptr->start_index);
+        return 0;
+    }
+    if (p_ptr->generation != p_pool->generation) {
+        print_error("The pointer at address %" PRId64 " is not valid anymore.", p_ptr->start_index);
+        return 0;
+    }
+
+    size_t offset = (size_t)p_ptr->start_index - p_memory->blocks.p_start_indices[p_pool->block];
+    if (offset % p_pool->object_size != 0 || offset / p_pool->object_size >= p_pool->count) { // Doesn't point at the start of an object
+        print_error("The pointer at address %" PRId64 " does not point at an object of its pool.", p_ptr->start_index);
+        return 0;
+    }
+
+    shadow_clear(p_memory->p_shadow, (size_t)p_ptr->start_index, p_pool->object_size); // Garbage for the next pool_alloc (the link is not a value)
+    watch_free(p_memory, (size_t)p_ptr->start_index, p_pool->object_size);
+    memcpy(p_memory->p_bytes + p_ptr->start_index, &p_pool->free_head, sizeof(p_pool->free_head)); // The old head is next after this object
+    watch_write(p_memory, (size_t)p_ptr->start_index, sizeof(p_pool->free_head), "pool_free");
+    p_pool->free_head = (uint32_t)(offset / p_pool->object_size);
+    p_pool->used--;
+    return 1;
+}
@@ -0,0 +1,89 @@
+#include "regions.h"
+
+// Names of the region types, for messages and visualize_blocks
+const char *arr_region_type_names[] = {
+    [ARENA] = "arena",
+    [POOL] = "pool",
+    [NURSERY] = "nursery"
+};
+
+// Names of the commands that release the allocations of each region type, for error messages
+const char *arr_region_release_commands[] = {
+    [ARENA] = "arena_reset",
+    [POOL] = "pool_free",
+    [NURSERY] = "free"
+};
+
+// Carves a block for a new region out of the memory (with the allocator chosen at startup) and saves the region by its name
+//
+// Input : A pointer to the memory, the name of the new region, its type and the size of its block
+//
+// Output : Returns a pointer to the new region in memory->p_regions, or NULL (after printing an error) if the name is taken or there is not enough memory
+Region* create_region(Memory *p_memory, char *name, Region_Type type, size_t size) {
+    if (hashmap_get(p_memory->p_regions, name) != NULL) { // Regions own their block, so overwriting one would leak it
+        print_error("A region with the name %s already exists.", name);
+        return NULL;
+    }
+
+    Pointer block_ptr = {0}; // Only used to get the start of the block
+    if (!my_malloc(p_memory, size, &block_ptr)) {
+        print_error("Could not allocate %zu bytes for %s %s.", size, arr_region_type_names[type], name);
+        return NULL;
+    }
+    BlockId block = find_block(p_memory, (size_t)block_ptr.start_index);
+    p_memory->blocks.p_states[block] |= BLOCK_REGION; // So visualize_blocks can show it as a region
+
+    Region *p_region = malloc(sizeof(Region)); // Put the region on the heap (so it can be used in the hashmap)
+    if (!p_region) {
+        fprintf(stderr, "Memory allocation failed for Region struct!\n");
+        exit(1);
+    }
+    *p_region = (Region){
+        .type = type,
+        .block = block,
+        .generation = 0,
+        .used = 0,
+        .object_size = 0,
+        .count = 0,
+        .free_head = 0
+    };
+    hashmap_insert(p_memory->p_regions, name, p_region, (uint8_t)1); // Name was checked above, so no warning is needed
+    return p_region;
+}
+
+// Gets a region by its name, and makes sure it is of the type the command expects
+//
+// Input : A pointer to the memory, the name of the region and the type it should be
+//
+// Output : Returns a pointer to the region, or NULL (after printing an error) if there is no region of that type with that name
+Region* get_region(Memory *p_memory, char *name, Region_Type type) {
+    Region *p_region = (Region*)hashmap_get(p_memory->p_regions, name);
+    if (p_region == NULL) {
+        print_error("Could not locate %s %s. Please create it with the command %s_create.", arr_region_type_names[type], name, arr_region_type_names[type]);
+        return NULL;
+    }
+    if (p_region->type != type) {
+        print_error("%s is a %s, not a %s.", name, arr_region_type_names[p_region->type], arr_region_type_names[type]);
+        return NULL;
+    }
+    return p_region;
+}
+
+// Finds the region that owns a block, by going over all the regions (only used for visualization)
+//
+// Input : A pointer to the memory, the id of a block with the BLOCK_REGION state, and a pointer to where to put the region
+//
+// Output : Returns the name of the region and puts the region in *pp_region, or returns NULL if no region owns the block
+char* find_region_of_block(Memory *p_memory, BlockId block, Region **pp_region) {
+    HashMap *p_regions = p_memory->p_regions; // Readability
+    for (size_t i = 0; i < p_regions->bucket_size; i++) {
+        for (HashNode *p_node = p_regions->pp_map[i]; p_node != NULL; p_node = p_node->p_next) {
+            Region *p_region = (Region*)p_node->p_value;
+            if (p_region->block == block) {
+                *pp_region = p_region;
+                return p_node->p_key;
+            }
+        }
+    }
+    return NULL;
+}
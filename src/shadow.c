@@ -0,0 +1,171 @@
+#include "shadow.h"
+
+// Calculates how many bytes the shadow of a memory takes
+//
+// Input : The size of the memory in bytes
+//
+// Output : Returns the size in bytes of the shadow (whole uint64_t words, one bit for every byte)
+size_t shadow_storage_size(size_t memory_size) {
+    return (memory_size + 63) / 64 * sizeof(uint64_t);
+}
+
+// Marks bytes as written
+//
+// Input : The shadow, the index of the first byte and how many bytes
+//
+// Output : Their bits are on
+void shadow_set(uint64_t *p_shadow, size_t start, size_t size) {
+    shadow_fill(p_shadow, start, size, 1);
+}
+
+// Marks bytes as garbage, like when their block is freed
+//
+// Input : The shadow, the index of the first byte and how many bytes
+//
+// Output : Their bits are off
+void shadow_clear(uint64_t *p_shadow, size_t start, size_t size) {
+    shadow_fill(p_shadow, start, size, 0);
+}
+
+// Turns the bits of a range on or off, the words between the first and the last one are written with memset
+//
+// Input : The shadow, the index of the first byte, how many bytes and the value of the bits (0 or 1)
+//
+// Output : The bits of the range are <on>
+void shadow_fill(uint64_t *p_shadow, size_t start, size_t size, uint8_t on) {
+    if (size == 0) {
+        return;
+    }
+    size_t first_word = start / 64;
+    size_t last_word = (start + size - 1) / 64;
+    uint64_t first_mask = UINT64_MAX << (start % 64); // The bits of the range in the first word
+    uint64_t last_mask = UINT64_MAX >> (63 - (start + size - 1) % 64); // The bits of the range in the last word
+
+    if (first_word == last_word) {
+        first_mask &= last_mask;
+    } else {
+        p_shadow[last_word] = on ? (p_shadow[last_word] | last_mask) : (p_shadow[last_word] & ~last_mask);
+        memset(p_shadow + first_word + 1, on ? 0xFF : 0, (last_word - first_word - 1) * sizeof(uint64_t)); // The C library sets them with SIMD stores
+    }
+    p_shadow[first_word] = on ? (p_shadow[first_word] | first_mask) : (p_shadow[first_word] & ~first_mask);
+}
+
+// Finds the first byte of a range that was never written
+//
+// Input : The shadow, the index of the first byte and how many bytes
+//
+// Output : Returns the offset of the first byte whose bit is off from start, or size if all of them were written
+size_t shadow_find_unset(const uint64_t *p_shadow, size_t start, size_t size) {
+    size_t index = start;
+    size_t end = start + size;
+    while (index < end) {
+        size_t bit = index % 64;
+        size_t word = index / 64;
+        if (bit == 0 && end - index >= 4 * 64
+            && (p_shadow[word] & p_shadow[word + 1] & p_shadow[word + 2] & p_shadow[word + 3]) == UINT64_MAX) { // 256 written bytes in one test
+            index += 4 * 64;
+            continue;
+        }
+
+        size_t in_word = (end - index < 64 - bit) ? end - index : 64 - bit; // The bits of the range in this word
+        uint64_t missing = ~p_shadow[word] >> bit;
+        if (in_word < 64) {
+            missing &= ((uint64_t)1 << in_word) - 1;
+        }
+        if (missing != 0) {
+            return index - start + (size_t)__builtin_ctzll(missing);
+        }
+        index += in_word;
+    }
+    return size;
+}
+
+// Counts the written bytes of a range
+//
+// Input : The shadow, the index of the first byte and how many bytes
+//
+// Output : Returns how many bits of the range are on
+size_t shadow_count(const uint64_t *p_shadow, size_t start, size_t size) {
+    size_t count = 0;
+    size_t index = start;
+    size_t end = start + size;
+    while (index < end) {
+        size_t bit = index % 64;
+        size_t in_word = (end - index < 64 - bit) ? end - index : 64 - bit;
+        uint64_t written = p_shadow[index / 64] >> bit;
+        if (in_word < 64) {
+            written &= ((uint64_t)1 << in_word) - 1;
+        }
+        count += (size_t)__builtin_popcountll(written);
+        index += in_word;
+    }
+    return count;
+}
+
+// Copies the bits of a range to another range, of the same shadow (like memmove, they can overlap) or of another one
+//
+// Input : The shadow to copy to and the first bit there, the shadow to copy from and the first bit there, and how many bits
+//
+// Output : The bits of the destination are the bits the source had
+void shadow_copy(uint64_t *p_dst, size_t dst_start, const uint64_t *p_src, size_t src_start, size_t size) {
+    // 64 bits at a time. When the destination is after the source in the same shadow, the copy goes from the end,
+    // so no bit is written over before it is read (like a block that moves right)
+    if (p_dst == p_src && dst_start > src_start) {
+        size_t left = size;
+        while (left > 0) {
+            size_t count = (left < 64) ? left : 64;
+            left -= count;
+            shadow_write_bits(p_dst, dst_start + left, count, shadow_read_bits(p_src, src_start + left, count));
+        }
+        return;
+    }
+    for (size_t done = 0; done < size; done += 64) {
+        size_t count = (size - done < 64) ? size - done : 64;
+        shadow_write_bits(p_dst, dst_start + done, count, shadow_read_bits(p_src, src_start + done, count));
+    }
+}
+
+// Reads up to 64 bits that start anywhere in a shadow
+//
+// Input : The shadow, the first bit and how many bits (1-64)
+//
+// Output : Returns the bits, the first one is the lowest bit
+uint64_t shadow_read_bits(const uint64_t *p_shadow, size_t first, size_t count) {
+    size_t word = first / 64;
+    size_t bit = first % 64;
+    uint64_t bits = p_shadow[word] >> bit;
+    if (bit != 0 && bit + count > 64) { // The rest of the bits are at the bottom of the next word
+        bits |= p_shadow[word + 1] << (64 - bit);
+    }
+    return (count == 64) ? bits : bits & (((uint64_t)1 << count) - 1);
+}
+
+// Writes up to 64 bits that start anywhere in a shadow, without changing the bits around them
+//
+// Input : The shadow, the first bit, how many bits (1-64) and their values (the first one is the lowest bit)
+//
+// Output : The bits are written
+void shadow_write_bits(uint64_t *p_shadow, size_t first, size_t count, uint64_t bits) {
+    size_t word = first / 64;
+    size_t bit = first % 64;
+    uint64_t mask = (count == 64) ? UINT64_MAX : ((uint64_t)1 << count) - 1;
+    bits &= mask;
+    p_shadow[word] = (p_shadow[word] & ~(mask << bit)) | (bits << bit);
+    if (bit != 0 && bit + count > 64) {
+        p_shadow[word + 1] = (p_shadow[word + 1] & ~(mask >> (64 - bit))) | (bits >> (64 - bit));
+    }
+}
+
+// Checks that every byte a command reads was written, so garbage is never shown or used
+//
+// Input : A pointer to the memory, the index of the first byte and how many bytes
+//
+// Output : Returns a boolean (0 or 1) if all of them were written or not (after printing the address of the first one that wasn't)
+uint8_t shadow_check(Memory *p_memory, size_t start, size_t size) {
+    size_t offset = shadow_find_unset(p_memory->p_shadow, start, size);
+    if (offset != size) {
+        print_error("The byte at address %zu was never written, it holds a garbage value.", start + offset);
+        return 0;
+    }
+    return 1;
+}
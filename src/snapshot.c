@@ -0,0 +1,458 @@
+#include "snapshot.h"
+
+// Arguments parser for the snapshot_save function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function snapshot_save if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status snapshot_save_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function snapshot_save. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    size_t file_size;
+    uint8_t success = snapshot_save(p_memory, args[0], &file_size);
+    if (success) {
+        print_success("Saved a snapshot of %zu bytes to %s successfully.", file_size, args[0]);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Arguments parser for the snapshot_load function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function snapshot_load if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status snapshot_load_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function snapshot_load. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    uint8_t success = snapshot_load(p_memory, args[0]);
+    if (success) {
+        print_success("Loaded the snapshot %s successfully, there are %zu blocks now.", args[0], p_memory->amount_of_blocks);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Writes the blocks, the regions, the pointers and the bytes of the allocated blocks to a file, so snapshot_load can restore them
+// without running the commands that made them again
+//
+// Input : A pointer to the memory and the path of the file
+//
+// Output : Writes the snapshot (see Snapshot_Header) and puts its size in *p_file_size, returns a boolean (0 or 1) if it succeded or not
+uint8_t snapshot_save(Memory *p_memory, const char *path, size_t *p_file_size) {
+    FILE *p_file = fopen(path, "wb");
+    if (p_file == NULL) {
+        print_error("Could not open the file %s for writing.", path);
+        return 0;
+    }
+
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    HashMap *p_regions = p_memory->p_regions;
+    HashMap *p_pointers = p_memory->p_pointers;
+
+    Snapshot_Header header = {0};
+    memcpy(header.arr_magic, SNAPSHOT_MAGIC, sizeof(header.arr_magic));
+    header.version = SNAPSHOT_VERSION;
+    header.allocator = (uint32_t)p_memory->allocator;
+    header.memory_size = p_memory->memory_size;
+
+    // The blocks are saved in the order of the linked list, so the regions save the index of their block in that order
+    uint64_t *p_order = malloc(p_memory->amount_of_used_slots * sizeof(uint64_t));
+    if (!p_order) {
+        fprintf(stderr, "Memory allocation failed for the order of the blocks!\n");
+        exit(1);
+    }
+    for (BlockId curr = p_memory->first_block; curr != NO_BLOCK; curr = p_table->p_next[curr]) {
+        p_order[curr] = header.amount_of_blocks++;
+        if (!(p_table->p_states[curr] & BLOCK_FREE)) {
+            header.image_size += p_table->p_sizes[curr];
+        }
+    }
+
+    // The pointers save the index of their region, in the order the regions are saved
+    for (size_t i = 0; i < p_regions->bucket_size; i++) {
+        for (HashNode *p_node = p_regions->pp_map[i]; p_node != NULL; p_node = p_node->p_next) {
+            header.amount_of_regions++;
+        }
+    }
+    Region **pp_saved_regions = malloc((header.amount_of_regions + 1) * sizeof(Region*)); // + 1 so it is never malloc(0)
+    if (!pp_saved_regions) {
+        fprintf(stderr, "Memory allocation failed for the saved regions!\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < p_pointers->bucket_size; i++) {
+        for (HashNode *p_node = p_pointers->pp_map[i]; p_node != NULL; p_node = p_node->p_next) {
+            header.amount_of_pointers++;
+        }
+    }
+    fwrite(&header, sizeof(header), 1, p_file);
+
+    // The sizes and then the states, like the struct of arrays of the block table
+    for (BlockId curr = p_memory->first_block; curr != NO_BLOCK; curr = p_table->p_next[curr]) {
+        uint64_t size = p_table->p_sizes[curr];
+        fwrite(&size, sizeof(size), 1, p_file);
+    }
+    for (BlockId curr = p_memory->first_block; curr != NO_BLOCK; curr = p_table->p_next[curr]) {
+        fwrite(&p_table->p_states[curr], sizeof(uint8_t), 1, p_file);
+    }
+
+    size_t amount_of_saved_regions = 0;
+    for (size_t i = 0; i < p_regions->bucket_size; i++) {
+        for (HashNode *p_node = p_regions->pp_map[i]; p_node != NULL; p_node = p_node->p_next) {
+            Region *p_region = (Region*)p_node->p_value;
+            Snapshot_Region saved;
+            memset(&saved, 0, sizeof(saved)); // No garbage in the padding
+            saved.block = p_order[p_region->block];
+            saved.used = p_region->used;
+            saved.type = (uint32_t)p_region->type;
+            saved.generation = p_region->generation;
+            saved.object_size = p_region->object_size;
+            saved.count = p_region->count;
+            saved.free_head = p_region->free_head;
+            saved.name_length = (uint32_t)strlen(p_node->p_key);
+            fwrite(&saved, sizeof(saved), 1, p_file);
+            fwrite(p_node->p_key, 1, saved.name_length, p_file);
+            pp_saved_regions[amount_of_saved_regions++] = p_region;
+        }
+    }
+
+    for (size_t i = 0; i < p_pointers->bucket_size; i++) {
+        for (HashNode *p_node = p_pointers->pp_map[i]; p_node != NULL; p_node = p_node->p_next) {
+            Pointer *p_ptr = (Pointer*)p_node->p_value;
+            Snapshot_Pointer saved;
+            memset(&saved, 0, sizeof(saved));
+            saved.start_index = p_ptr->start_index;
+            saved.size = p_ptr->size;
+            saved.region = SNAPSHOT_NO_REGION;
+            for (size_t j = 0; j < amount_of_saved_regions; j++) { // There are only a few regions
+                if (pp_saved_regions[j] == p_ptr->p_region) {
+                    saved.region = (uint32_t)j;
+                }
+            }
+            saved.generation = p_ptr->generation;
+            saved.name_length = (uint32_t)strlen(p_node->p_key);
+            fwrite(&saved, sizeof(saved), 1, p_file);
+            fwrite(p_node->p_key, 1, saved.name_length, p_file);
+        }
+    }
+    free(pp_saved_regions);
+    free(p_order);
+
+    // The image, free blocks are skipped so a fragmented memory doesn't write its garbage
+    // Which of its bytes were written is gathered into the shadow of the image on the way, and written after it
+    uint64_t *p_image_shadow = calloc(shadow_storage_size((size_t)header.image_size) + sizeof(uint64_t), 1); // + 1 word so it is never calloc(0)
+    if (!p_image_shadow) {
+        fprintf(stderr, "Memory allocation failed for the shadow of the image!\n");
+        exit(1);
+    }
+    size_t image_index = 0;
+    for (BlockId curr = p_memory->first_block; curr != NO_BLOCK; curr = p_table->p_next[curr]) {
+        if (!(p_table->p_states[curr] & BLOCK_FREE)) {
+            fwrite(p_memory->p_bytes + p_table->p_start_indices[curr], 1, p_table->p_sizes[curr], p_file);
+            shadow_copy(p_image_shadow, image_index, p_memory->p_shadow, p_table->p_start_indices[curr], p_table->p_sizes[curr]);
+            image_index += p_table->p_sizes[curr];
+        }
+    }
+    fwrite(p_image_shadow, 1, shadow_storage_size((size_t)header.image_size), p_file);
+    free(p_image_shadow);
+
+    long file_size = ftell(p_file);
+    uint8_t failed = (uint8_t)ferror(p_file);
+    if (fclose(p_file) != 0 || failed) { // fclose writes what is left in the buffer, so it can fail as well
+        print_error("Could not write the snapshot to %s.", path);
+        return 0;
+    }
+    *p_file_size = (size_t)file_size;
+    return 1;
+}
+
+// Replaces the blocks, the regions and the pointers of the memory with the ones in a snapshot file
+//
+// Input : A pointer to the memory and the path of the file
+//
+// Output : Restores the snapshot, growing the memory if the snapshot is bigger (a smaller snapshot is followed by a free block),
+// returns a boolean (0 or 1) if it succeded or not (then the memory didn't change)
+uint8_t snapshot_load(Memory *p_memory, const char *path) {
+    size_t file_size;
+    const uint8_t *p_file = map_file(path, &file_size); // No copy of the file, the image is copied once, from the page cache to the bytes array
+    if (p_file == NULL) {
+        print_error("Could not open the snapshot %s.", path);
+        return 0;
+    }
+
+    Snapshot_View view;
+    uint8_t success = snapshot_parse(p_file, file_size, p_memory->allocator, &view);
+    if (success && view.header.memory_size > backing_max_size(p_memory->backing)) {
+        print_error("The snapshot is %" PRIu64 " bytes, a memory here can be at most %zu bytes.", view.header.memory_size, backing_max_size(p_memory->backing));
+        success = 0;
+    }
+    if (success && view.header.memory_size > p_memory->memory_size) {
+        success = grow_memory(p_memory, view.header.memory_size); // Prints why it can't (like a memory on the stack)
+    }
+    if (success) {
+        snapshot_restore(p_memory, &view);
+    }
+    unmap_file(p_file, file_size);
+    return success;
+}
+
+// Checks that a snapshot file is whole and valid before anything in the memory is changed
+//
+// Input : A pointer to the bytes of the file, its size, the allocator of the memory and a pointer to where to put where every part starts
+//
+// Output : Fills *p_view and returns 1, or prints what is wrong and returns 0
+uint8_t snapshot_parse(const uint8_t *p_file, size_t file_size, Allocator_Type allocator, Snapshot_View *p_view) {
+    const uint8_t *p_cursor = p_file;
+    const uint8_t *p_end = p_file + file_size;
+    Snapshot_Header *p_header = &p_view->header; // Readability
+
+    const uint8_t *p_part = snapshot_skip(&p_cursor, p_end, sizeof(Snapshot_Header));
+    if (p_part == NULL || memcmp(p_part, SNAPSHOT_MAGIC, sizeof(p_header->arr_magic)) != 0) {
+        print_error("The file is not a snapshot.");
+        return 0;
+    }
+    memcpy(p_header, p_part, sizeof(Snapshot_Header));
+    if (p_header->version != SNAPSHOT_VERSION) {
+        print_error("The snapshot is of version %u, only version %d can be loaded.", p_header->version, SNAPSHOT_VERSION);
+        return 0;
+    }
+    if (p_header->allocator >= AMOUNT_OF_ALLOCATORS || p_header->allocator != (uint32_t)allocator) { // The blocks (and the bins) are only valid for the allocator that split them
+        print_error("The snapshot was saved with a different allocator, the memory uses %s.", arr_allocators[allocator].p_name);
+        return 0;
+    }
+    if (p_header->amount_of_blocks == 0 || p_header->amount_of_blocks > file_size || p_header->amount_of_blocks > p_header->memory_size) {
+        print_error("The snapshot has %" PRIu64 " blocks, which can't be.", p_header->amount_of_blocks);
+        return 0;
+    }
+
+    size_t amount_of_blocks = (size_t)p_header->amount_of_blocks;
+    p_view->p_sizes = snapshot_skip(&p_cursor, p_end, amount_of_blocks * sizeof(uint64_t));
+    p_view->p_states = snapshot_skip(&p_cursor, p_end, amount_of_blocks);
+    if (p_view->p_states == NULL) {
+        print_error("The snapshot ends in the middle of its blocks.");
+        return 0;
+    }
+    uint64_t memory_size = 0, image_size = 0;
+    for (size_t i = 0; i < amount_of_blocks; i++) {
+        uint64_t size;
+        memcpy(&size, p_view->p_sizes + i * sizeof(uint64_t), sizeof(size));
+        uint8_t state = p_view->p_states[i];
+        if (size == 0 || size > p_header->memory_size || (state & ~(BLOCK_FREE | BLOCK_REGION))) {
+            print_error("Block %zu of the snapshot is not valid.", i);
+            return 0;
+        }
+        memory_size += size;
+        if (!(state & BLOCK_FREE)) {
+            image_size += size;
+        }
+    }
+    if (memory_size != p_header->memory_size || image_size != p_header->image_size) {
+        print_error("The blocks of the snapshot don't add up to its size.");
+        return 0;
+    }
+
+    p_view->p_regions = p_cursor;
+    for (uint64_t i = 0; i < p_header->amount_of_regions; i++) {
+        Snapshot_Region saved;
+        p_part = snapshot_skip(&p_cursor, p_end, sizeof(saved));
+        if (p_part == NULL) {
+            print_error("The snapshot ends in the middle of its regions.");
+            return 0;
+        }
+        memcpy(&saved, p_part, sizeof(saved));
+        if (saved.block >= amount_of_blocks || !(p_view->p_states[saved.block] & BLOCK_REGION) || saved.type > NURSERY
+            || saved.name_length == 0 || saved.name_length >= MAX_INPUT_SIZE || snapshot_skip(&p_cursor, p_end, saved.name_length) == NULL) {
+            print_error("Region %" PRIu64 " of the snapshot is not valid.", i);
+            return 0;
+        }
+    }
+
+    p_view->p_pointers = p_cursor;
+    for (uint64_t i = 0; i < p_header->amount_of_pointers; i++) {
+        Snapshot_Pointer saved;
+        p_part = snapshot_skip(&p_cursor, p_end, sizeof(saved));
+        if (p_part == NULL) {
+            print_error("The snapshot ends in the middle of its pointers.");
+            return 0;
+        }
+        memcpy(&saved, p_part, sizeof(saved));
+        if ((saved.region != SNAPSHOT_NO_REGION && saved.region >= p_header->amount_of_regions) || saved.start_index >= (int64_t)memory_size
+            || saved.name_length == 0 || saved.name_length >= MAX_INPUT_SIZE || snapshot_skip(&p_cursor, p_end, saved.name_length) == NULL) {
+            print_error("Pointer %" PRIu64 " of the snapshot is not valid.", i);
+            return 0;
+        }
+    }
+
+    p_view->p_image = snapshot_skip(&p_cursor, p_end, (size_t)image_size);
+    p_view->p_image_shadow = snapshot_skip(&p_cursor, p_end, shadow_storage_size((size_t)image_size));
+    if (p_view->p_image_shadow == NULL || p_cursor != p_end) {
+        print_error("The image of the snapshot and its shadow are not %" PRIu64 " and %zu bytes.", image_size, shadow_storage_size((size_t)image_size));
+        return 0;
+    }
+    return 1;
+}
+
+// Builds the block table, the block map, the bins, the regions and the pointers from a parsed snapshot, and copies the image
+//
+// Input : A pointer to the memory (at least as big as the snapshot) and a view that snapshot_parse filled
+//
+// Output : The memory is the memory that was saved, and free after the size of the snapshot
+void snapshot_restore(Memory *p_memory, const Snapshot_View *p_view) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    const Snapshot_Header *p_header = &p_view->header;
+
+    // Everything that points at a block goes, the regions and the pointers of the snapshot replace them
+    // The hashmaps don't grow, so a snapshot with a lot of pointers gets enough buckets for them (one per pointer) instead of long chains
+    size_t pointers_bucket_size = p_memory->p_pointers->bucket_size;
+    if (p_header->amount_of_pointers > pointers_bucket_size) {
+        pointers_bucket_size = (size_t)p_header->amount_of_pointers;
+    }
+    size_t regions_bucket_size = p_memory->p_regions->bucket_size;
+    hashmap_free(p_memory->p_pointers);
+    hashmap_free(p_memory->p_regions);
+    *p_memory->p_pointers = init_hashmap(pointers_bucket_size);
+    *p_memory->p_regions = init_hashmap(regions_bucket_size);
+    p_memory->p_nursery = NULL;
+
+    // An empty table, map and bins, like at startup
+    p_memory->free_slots = NO_BLOCK;
+    p_memory->amount_of_used_slots = 0;
+    p_memory->amount_of_blocks = 0;
+    size_t block_map_size = (p_memory->memory_size + BLOCK_MAP_PAGE_SIZE - 1) / BLOCK_MAP_PAGE_SIZE; // Same as in main
+    memset(p_memory->p_block_map, 0, block_map_size * sizeof(BlockId));
+    size_t pointer_index_size = (p_memory->memory_size + POINTER_INDEX_PAGE_SIZE - 1) / POINTER_INDEX_PAGE_SIZE; // The pointers it links were freed above
+    memset(p_memory->pp_pointer_index, 0, pointer_index_size * sizeof(Pointer*));
+    p_memory->free_bins_bitmap = 0;
+    for (int i = 0; i < AMOUNT_OF_SIZE_CLASSES; i++) {
+        p_memory->arr_free_bins[i] = NO_BLOCK;
+        p_memory->arr_tlsf_sl_bitmaps[i] = 0;
+        for (int j = 0; j < TLSF_SL_COUNT; j++) {
+            p_memory->arr_tlsf_lists[i][j] = NO_BLOCK;
+        }
+    }
+
+    // The shadow of the image is copied to whole words, so the bits can be copied to the shadow of the memory a word at a time
+    size_t image_shadow_size = shadow_storage_size((size_t)p_header->image_size);
+    uint64_t *p_image_shadow = malloc(image_shadow_size + sizeof(uint64_t)); // + 1 word so it is never malloc(0)
+    if (!p_image_shadow) {
+        fprintf(stderr, "Memory allocation failed for the shadow of the image!\n");
+        exit(1);
+    }
+    memcpy(p_image_shadow, p_view->p_image_shadow, image_shadow_size);
+    shadow_clear(p_memory->p_shadow, 0, p_memory->memory_size); // Free bytes hold garbage, the allocated ones get their bits below
+    watch_free(p_memory, 0, p_memory->memory_size); // The bytes of the snapshot replace all of them
+
+    // The slots are handed out in order, so the id of every block is its index in the snapshot
+    size_t start = 0;
+    const uint8_t *p_image = p_view->p_image;
+    for (size_t i = 0; i < p_header->amount_of_blocks; i++) {
+        BlockId block = take_block_slot(p_memory); // Can't fail, there are less blocks than bytes in the snapshot
+        uint64_t size;
+        memcpy(&size, p_view->p_sizes + i * sizeof(uint64_t), sizeof(size));
+        p_table->p_sizes[block] = (size_t)size;
+        p_table->p_start_indices[block] = start;
+        p_table->p_states[block] = p_view->p_states[i];
+        p_table->p_prev[block] = (i == 0) ? NO_BLOCK : block - 1;
+        p_table->p_next[block] = NO_BLOCK;
+        p_table->p_next_free[block] = NO_BLOCK;
+        p_table->p_prev_free[block] = NO_BLOCK;
+        if (i > 0) {
+            p_table->p_next[block - 1] = block;
+        }
+        block_map_insert(p_memory, block);
+
+        if (p_table->p_states[block] & BLOCK_FREE) {
+            free_bins_insert(p_memory, block);
+        } else {
+            memcpy(p_memory->p_bytes + start, p_image, (size_t)size);
+            shadow_copy(p_memory->p_shadow, start, p_image_shadow, (size_t)(p_image - p_view->p_image), (size_t)size);
+            p_image += size;
+        }
+        start += (size_t)size;
+    }
+    free(p_image_shadow);
+    p_memory->first_block = 0;
+    if (start < p_memory->memory_size) { // The memory is bigger than the snapshot
+        append_free_memory(p_memory, start, p_memory->memory_size - start);
+    }
+    p_memory->next_fit_rover = NO_BLOCK; // The block it pointed at might be gone
+    p_memory->defrag_position = 0;
+
+    Region **pp_loaded_regions = malloc((p_header->amount_of_regions + 1) * sizeof(Region*)); // + 1 so it is never malloc(0)
+    if (!pp_loaded_regions) {
+        fprintf(stderr, "Memory allocation failed for the loaded regions!\n");
+        exit(1);
+    }
+    char name[MAX_INPUT_SIZE]; // snapshot_parse made sure every name is shorter
+    const uint8_t *p_cursor = p_view->p_regions;
+    for (size_t i = 0; i < p_header->amount_of_regions; i++) {
+        Snapshot_Region saved;
+        memcpy(&saved, p_cursor, sizeof(saved));
+        memcpy(name, p_cursor + sizeof(saved), saved.name_length);
+        name[saved.name_length] = '\0';
+        p_cursor += sizeof(saved) + saved.name_length;
+
+        Region *p_region = malloc(sizeof(Region)); // Put the region on the heap (so it can be used in the hashmap)
+        if (!p_region) {
+            fprintf(stderr, "Memory allocation failed for Region struct!\n");
+            exit(1);
+        }
+        *p_region = (Region){
+            .type = (Region_Type)saved.type,
+            .block = (BlockId)saved.block,
+            .generation = saved.generation,
+            .used = (size_t)saved.used,
+            .object_size = saved.object_size,
+            .count = saved.count,
+            .free_head = saved.free_head
+        };
+        hashmap_insert(p_memory->p_regions, name, p_region, (uint8_t)1);
+        if (p_region->type == NURSERY) {
+            p_memory->p_nursery = p_region;
+        }
+        pp_loaded_regions[i] = p_region;
+    }
+
+    p_cursor = p_view->p_pointers;
+    for (size_t i = 0; i < p_header->amount_of_pointers; i++) {
+        Snapshot_Pointer saved;
+        memcpy(&saved, p_cursor, sizeof(saved));
+        memcpy(name, p_cursor + sizeof(saved), saved.name_length);
+        name[saved.name_length] = '\0';
+        p_cursor += sizeof(saved) + saved.name_length;
+
+        Pointer *p_ptr = malloc(sizeof(Pointer)); // Put the pointer on the heap (so it can be used in the hashmap)
+        if (!p_ptr) {
+            fprintf(stderr, "Memory allocation failed for Pointer struct!\n");
+            exit(1);
+        }
+        *p_ptr = (Pointer){
+            .start_index = saved.start_index,
+            .size = (size_t)saved.size,
+            .p_region = (saved.region == SNAPSHOT_NO_REGION) ? NULL : pp_loaded_regions[saved.region],
+            .generation = saved.generation
+        };
+        hashmap_insert(p_memory->p_pointers, name, p_ptr, (uint8_t)1);
+        pointer_index_update(p_memory, p_ptr);
+    }
+    free(pp_loaded_regions);
+}
+
+// Moves a cursor over the next part of a snapshot file
+//
+// Input : A pointer to the cursor, the end of the file and the size of the part
+//
+// Output : Returns where the part starts and moves the cursor after it, or NULL if the file ends before the part does
+const uint8_t* snapshot_skip(const uint8_t **pp_cursor, const uint8_t *p_end, size_t size) {
+    if (*pp_cursor == NULL || size > (size_t)(p_end - *pp_cursor)) {
+        *pp_cursor = NULL; // Every part after this one is missing as well
+        return NULL;
+    }
+    const uint8_t *p_part = *pp_cursor;
+    *pp_cursor += size;
+    return p_part;
+}
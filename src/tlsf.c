@@ -0,0 +1,99 @@
+#include "tlsf.h"
+
+// Gets the first level (power of two range) and second level (linear part of the range) of the TLSF list that a free block of <size> bytes belongs to
+//
+// Input : A size in bytes (must be more than 0), and pointers to where to put the two levels
+//
+// Output : *p_fl is floor(log2(size)), and *p_sl is which of the TLSF_SL_COUNT equal parts of [2^fl, 2^(fl+1)) the size is in
+void tlsf_mapping(size_t size, unsigned int *p_fl, unsigned int *p_sl) {
+    unsigned int fl = size_class(size);
+    if (fl >= TLSF_SL_LOG2) { // The bits after the highest bit are the part of the range
+        *p_sl = (unsigned int)(size >> (fl - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT; // XOR turns off the highest bit
+    } else { // Small ranges have less sizes than parts, so every size gets its own part
+        *p_sl = (unsigned int)(size << (TLSF_SL_LOG2 - fl)) ^ TLSF_SL_COUNT;
+    }
+    *p_fl = fl;
+}
+
+// Adds a free block to the head of its TLSF list and turns on the bits of the list in both bitmaps
+//
+// Input : A pointer to the memory and the id of a free block
+//
+// Output : The block is linked into memory->arr_tlsf_lists
+void tlsf_insert(Memory *p_memory, BlockId block) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    unsigned int fl, sl;
+    tlsf_mapping(p_table->p_sizes[block], &fl, &sl);
+    BlockId old_head = p_memory->arr_tlsf_lists[fl][sl];
+
+    p_table->p_prev_free[block] = NO_BLOCK;
+    p_table->p_next_free[block] = old_head;
+    if (old_head != NO_BLOCK) {
+        p_table->p_prev_free[old_head] = block;
+    }
+    p_memory->arr_tlsf_lists[fl][sl] = block;
+
+    // The list and its first level are not empty anymore
+    p_memory->arr_tlsf_sl_bitmaps[fl] |= (uint32_t)1 << sl;
+    p_memory->free_bins_bitmap |= (uint64_t)1 << fl;
+}
+
+// Removes a free block from its TLSF list, and turns off the bits of the list if it became empty
+// Must be called before the size of the block changes, otherwise the wrong list is used
+//
+// Input : A pointer to the memory and the id of a free block that is in one of the lists
+//
+// Output : The block is unlinked from memory->arr_tlsf_lists
+void tlsf_remove(Memory *p_memory, BlockId block) {
+    BlockTable *p_table = &p_memory->blocks; // Readability
+    unsigned int fl, sl;
+    tlsf_mapping(p_table->p_sizes[block], &fl, &sl);
+    BlockId prev = p_table->p_prev_free[block];
+    BlockId next = p_table->p_next_free[block];
+
+    if (prev != NO_BLOCK) {
+        p_table->p_next_free[prev] = next;
+    } else { // The block is the head of the list
+        p_memory->arr_tlsf_lists[fl][sl] = next;
+    }
+    if (next != NO_BLOCK) {
+        p_table->p_prev_free[next] = prev;
+    }
+    p_table->p_next_free[block] = NO_BLOCK;
+    p_table->p_prev_free[block] = NO_BLOCK;
+
+    if (p_memory->arr_tlsf_lists[fl][sl] == NO_BLOCK) { // Last block of the list was removed
+        p_memory->arr_tlsf_sl_bitmaps[fl] &= ~((uint32_t)1 << sl);
+        if (!p_memory->arr_tlsf_sl_bitmaps[fl]) { // Last list of the first level
+            p_memory->free_bins_bitmap &= ~((uint64_t)1 << fl);
+        }
+    }
+}
+
+// Finds a free block that can hold <size> bytes with two bitmap lookups, without looking at any block
+//
+// Input : A pointer to the memory and the size of the allocation
+//
+// Output : Returns the id of the head of the first non empty list whose blocks are all at least <size> bytes, 
+// or NO_BLOCK if there is no such list
+BlockId tlsf_find(Memory *p_memory, size_t size) {
+    unsigned int fl = size_class(size);
+    if (fl >= TLSF_SL_LOG2) { // Round up to the start of the next part, so every block in the list that is found fits
+        size += ((size_t)1 << (fl - TLSF_SL_LOG2)) - 1;
+    }
+    unsigned int sl;
+    tlsf_mapping(size, &fl, &sl);
+    if (fl >= AMOUNT_OF_SIZE_CLASSES) return NO_BLOCK; // Bigger than any block can be
+
+    uint32_t sl_bitmap = p_memory->arr_tlsf_sl_bitmaps[fl] & (~(uint32_t)0 << sl); // Lists of the same first level that are big enough
+    if (!sl_bitmap) { // Go to the next non empty first level, every list there is big enough
+        if (fl + 1 >= AMOUNT_OF_SIZE_CLASSES) return NO_BLOCK;
+        uint64_t fl_bitmap = p_memory->free_bins_bitmap & (~(uint64_t)0 << (fl + 1));
+        if (!fl_bitmap) return NO_BLOCK; // No free block is big enough
+
+        fl = (unsigned int)__builtin_ctzll(fl_bitmap);
+        sl_bitmap = p_memory->arr_tlsf_sl_bitmaps[fl];
+    }
+    sl = (unsigned int)__builtin_ctz(sl_bitmap);
+    return p_memory->arr_tlsf_lists[fl][sl];
+}
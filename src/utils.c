@@ -60,7 +60,15 @@ void exit_program(char *name_of_program) {
     // Print "Thank you for using {program}. Exiting" with some ansi characters to be more fancy
     printf("\033[38;5;45mThank you for using \033[4;38;5;172m%s\033[0m\033[38;5;45m. Exiting",name_of_program); 
 
-    for (int i = 0; i < 3;i++){Sleep(667);printf(".");} // Closing three dots animation (adds a dot every 667 miliseconds). 
+    for (int i = 0; i < 3;i++){ // Closing three dots animation (adds a dot every 667 miliseconds). 
+#ifdef _WIN32
+        Sleep(667);
+#else
+        fflush(stdout); // The dots have no newline, without this they would all show up at the end
+        usleep(667 * 1000);
+#endif
+        printf(".");
+    }
 
     printf("\033[0m"); // Clear formating
     exit(0);
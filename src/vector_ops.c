@@ -0,0 +1,549 @@
+#include "vector_ops.h"
+
+#include <errno.h> // For the range errors of strtoull()
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VECTOR_X86 // The SSE2 and AVX2 kernels only exist on x86, everything else runs the scalar kernel
+#include <immintrin.h>
+#endif
+
+const Vector_Kernels arr_vector_kernels[AMOUNT_OF_BULK_KERNELS] = {
+    [BULK_SCALAR] = {"scalar", elementwise_scalar, reduce_scalar},
+#ifdef VECTOR_X86
+    [BULK_SSE2] = {"SSE2", elementwise_sse2, reduce_sse2},
+    [BULK_AVX2] = {"AVX2", elementwise_avx2, reduce_avx2},
+#else
+    [BULK_SSE2] = {"scalar", elementwise_scalar, reduce_scalar}, // Never chosen by select_bulk_kernels
+    [BULK_AVX2] = {"scalar", elementwise_scalar, reduce_scalar},
+#endif
+};
+
+const char *arr_vector_op_names[AMOUNT_OF_VECTOR_OPS] = {"vec_add", "vec_xor", "vec_and", "vec_or", "vec_shl"};
+const char *arr_vector_reduction_names[AMOUNT_OF_VECTOR_REDUCTIONS] = {"sum", "min", "max", "popcount"};
+
+// Arguments parsers of the elementwise commands, all of them call vector_elementwise_command with their operation
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function vector_elementwise if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status vec_add_command(Memory *p_memory, int args_c, char *args[10]) {
+    return vector_elementwise_command(p_memory, args_c, args, VEC_ADD);
+}
+
+Command_Status vec_xor_command(Memory *p_memory, int args_c, char *args[10]) {
+    return vector_elementwise_command(p_memory, args_c, args, VEC_XOR);
+}
+
+Command_Status vec_and_command(Memory *p_memory, int args_c, char *args[10]) {
+    return vector_elementwise_command(p_memory, args_c, args, VEC_AND);
+}
+
+Command_Status vec_or_command(Memory *p_memory, int args_c, char *args[10]) {
+    return vector_elementwise_command(p_memory, args_c, args, VEC_OR);
+}
+
+Command_Status vec_shl_command(Memory *p_memory, int args_c, char *args[10]) {
+    return vector_elementwise_command(p_memory, args_c, args, VEC_SHL);
+}
+
+// Arguments parsers of the reduction commands, all of them call vector_reduce_command with their reduction
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function vector_reduce if all the arguments are valid, prints the result and returns how the command ended (see Command_Status)
+Command_Status vec_sum_command(Memory *p_memory, int args_c, char *args[10]) {
+    return vector_reduce_command(p_memory, args_c, args, VEC_SUM);
+}
+
+Command_Status vec_min_command(Memory *p_memory, int args_c, char *args[10]) {
+    return vector_reduce_command(p_memory, args_c, args, VEC_MIN);
+}
+
+Command_Status vec_max_command(Memory *p_memory, int args_c, char *args[10]) {
+    return vector_reduce_command(p_memory, args_c, args, VEC_MAX);
+}
+
+Command_Status vec_popcount_command(Memory *p_memory, int args_c, char *args[10]) {
+    return vector_reduce_command(p_memory, args_c, args, VEC_POPCOUNT);
+}
+
+// Arguments parser for the vector_elementwise function
+//
+// Input : A pointer to the memory, the amount of arguments and the arguments (type, destination, source or bits, and the count)
+// and the operation
+//
+// Output : Calls the function vector_elementwise if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status vector_elementwise_command(Memory *p_memory, int args_c, char *args[10], Vector_Op op) {
+    const char *name = arr_vector_op_names[op]; // Readability
+    if (args_c != 3 && args_c != 4) {
+        print_error("Wrong amount of arguments for function %s. Expected 3 or 4 arguments but received %d arguments", name, args_c);
+        return COMMAND_FAILED;
+    }
+
+    const Scalar_Type *p_type;
+    uint8_t big_endian;
+    size_t count;
+    if (!parse_vector_arguments(args[0], args_c == 4 ? args[3] : NULL, &p_type, &big_endian, &count, name)) {
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_dst = (Pointer*)hashmap_get(p_memory->p_pointers, args[1]);
+    if (p_dst == NULL) {
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.", args[1]);
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_src = p_dst; // VEC_SHL has no source
+    uint64_t operand = 0;
+    if (op == VEC_SHL) {
+        char *endptr;
+        errno = 0;
+        operand = strtoull(args[2], &endptr, 10);
+        if (*endptr != '\0' || endptr == args[2] || args[2][0] == '-' || errno == ERANGE || operand >= 8u * p_type->width) {
+            print_error("Third argument in %s must be an integer between 0-%d <bits>, not %s.", name, 8 * p_type->width - 1, args[2]);
+            return COMMAND_FAILED;
+        }
+    } else {
+        p_src = (Pointer*)hashmap_get(p_memory->p_pointers, args[2]);
+        if (p_src == NULL) {
+            print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.", args[2]);
+            return COMMAND_FAILED;
+        }
+    }
+
+    uint8_t success = vector_elementwise(p_memory, op, p_type, big_endian, *p_dst, *p_src, operand, &count);
+    if (success) {
+        print_success("Ran %s on %zu %s elements of pointer %s successfully.", name, count, args[0], args[1]);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Arguments parser for the vector_reduce function
+//
+// Input : A pointer to the memory, the amount of arguments and the arguments (type, pointer and the count) and the reduction
+//
+// Output : Calls the function vector_reduce if all the arguments are valid, prints the result and returns how the command ended (see Command_Status)
+Command_Status vector_reduce_command(Memory *p_memory, int args_c, char *args[10], Vector_Reduction reduction) {
+    const char *name = arr_vector_reduction_names[reduction]; // Readability
+    char command[32]; // The name of the command for the errors, the name of the reduction is for the result
+    snprintf(command, sizeof(command), "vec_%s", name);
+    if (args_c != 2 && args_c != 3) {
+        print_error("Wrong amount of arguments for function %s. Expected 2 or 3 arguments but received %d arguments", command, args_c);
+        return COMMAND_FAILED;
+    }
+
+    const Scalar_Type *p_type;
+    uint8_t big_endian;
+    size_t count;
+    if (!parse_vector_arguments(args[0], args_c == 3 ? args[2] : NULL, &p_type, &big_endian, &count, command)) {
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_ptr = (Pointer*)hashmap_get(p_memory->p_pointers, args[1]);
+    if (p_ptr == NULL) {
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.", args[1]);
+        return COMMAND_FAILED;
+    }
+
+    uint64_t result;
+    uint8_t success = vector_reduce(p_memory, reduction, p_type, big_endian, *p_ptr, &count, &result);
+    if (success) {
+        print_success("The %s of the %zu %s elements of pointer %s is %" PRIu64 ".", name, count, args[0], args[1], result);
+    }
+    return success ? COMMAND_SUCCEEDED : COMMAND_FAILED;
+}
+
+// Applies an operation to every element of what a pointer points at, with the element at the same index of another pointer
+//
+// Input : A pointer to the memory, the operation, the type, the destination and the source (the destination again for VEC_SHL),
+// the bits to shift by (VEC_SHL) and a pointer to how many elements (VECTOR_WHOLE for all that fit, then it is set to the amount)
+//
+// Output : The elements of the destination are changed, returns a boolean (0 or 1) if it succeded or not
+uint8_t vector_elementwise(Memory *p_memory, Vector_Op op, const Scalar_Type *p_type, uint8_t big_endian, Pointer dst, Pointer src,
+    uint64_t operand, size_t *p_count) {
+    size_t dst_start, dst_size, src_start, src_size;
+    if (resolve_pointer(p_memory, dst, &dst_start, &dst_size) == NO_BLOCK || resolve_pointer(p_memory, src, &src_start, &src_size) == NO_BLOCK) {
+        return 0;
+    }
+
+    uint8_t width = p_type->width; // Readability
+    size_t fits = ((dst_size < src_size) ? dst_size : src_size) / width;
+    if (*p_count == VECTOR_WHOLE) {
+        *p_count = fits;
+    }
+    if (*p_count > fits) {
+        print_error("Can't use %zu elements of %u bytes, the pointers only have %zu of them.", *p_count, width, fits);
+        return 0;
+    }
+
+    // Every element is read before it is written, but the vectors of an overlapping source would be read after they were written over
+    size_t size = *p_count * width;
+    if (dst_start != src_start && dst_start < src_start + size && src_start < dst_start + size) {
+        print_error("The elements at address %zu and at address %zu overlap, the destination and the source have to be the same or apart.", src_start, dst_start);
+        return 0;
+    }
+    if (!shadow_check(p_memory, dst_start, size) || !shadow_check(p_memory, src_start, size)) { // Both are read, garbage in would be garbage out
+        return 0;
+    }
+
+    uint8_t swap = width > 1 && big_endian != host_is_big_endian();
+    uint8_t *p_dst = p_memory->p_bytes + dst_start;
+    const uint8_t *p_src = p_memory->p_bytes + src_start;
+    if (!arr_vector_kernels[p_memory->bulk_kernels].p_elementwise(op, width, swap, p_dst, p_src, operand, *p_count)) {
+        elementwise_scalar(op, width, swap, p_dst, p_src, operand, *p_count);
+    }
+    watch_write(p_memory, dst_start, size, arr_vector_op_names[op]);
+    return 1;
+}
+
+// Computes a reduction over the elements of what a pointer points at
+//
+// Input : A pointer to the memory, the reduction, the type, the pointer, a pointer to how many elements (VECTOR_WHOLE for all that fit,
+// then it is set to the amount) and where to put the result
+//
+// Output : Puts the result in *p_result, returns a boolean (0 or 1) if it succeded or not
+uint8_t vector_reduce(Memory *p_memory, Vector_Reduction reduction, const Scalar_Type *p_type, uint8_t big_endian, Pointer ptr,
+    size_t *p_count, uint64_t *p_result) {
+    size_t start, size;
+    if (resolve_pointer(p_memory, ptr, &start, &size) == NO_BLOCK) {
+        return 0;
+    }
+
+    uint8_t width = p_type->width; // Readability
+    if (*p_count == VECTOR_WHOLE) {
+        *p_count = size / width;
+    }
+    if (*p_count > size / width) {
+        print_error("Can't use %zu elements of %u bytes, the pointer only has %zu of them.", *p_count, width, size / width);
+        return 0;
+    }
+    if (*p_count == 0 && (reduction == VEC_MIN || reduction == VEC_MAX)) {
+        print_error("There is no %s of 0 elements.", arr_vector_reduction_names[reduction]);
+        return 0;
+    }
+    if (!shadow_check(p_memory, start, *p_count * width)) {
+        return 0;
+    }
+
+    uint8_t swap = width > 1 && big_endian != host_is_big_endian();
+    const uint8_t *p_src = p_memory->p_bytes + start;
+    *p_result = (reduction == VEC_MIN || reduction == VEC_MAX) ? read_element(p_src, width, swap) : 0;
+    if (!arr_vector_kernels[p_memory->bulk_kernels].p_reduce(reduction, width, swap, p_src, *p_count, p_result)) {
+        reduce_scalar(reduction, width, swap, p_src, *p_count, p_result);
+    }
+    return 1;
+}
+
+// Parses the type and the optional count of a vector command
+//
+// Input : The type argument, the count argument (NULL if it was not given), where to put the type, the byte order and the count,
+// and the name of the command
+//
+// Output : Returns a boolean (0 or 1) if they are valid or not (after printing an error)
+uint8_t parse_vector_arguments(const char *type_arg, const char *count_arg, const Scalar_Type **pp_type, uint8_t *p_big_endian,
+    size_t *p_count, const char *command) {
+    if (!parse_scalar_type(type_arg, pp_type, p_big_endian) || (*pp_type)->is_float) {
+        print_error("First argument in %s must be a type, u8, or u16, u32 or u64 followed by le or be (like u32le) <type>, not %s.", command, type_arg);
+        return 0;
+    }
+
+    *p_count = VECTOR_WHOLE;
+    if (count_arg == NULL) {
+        return 1;
+    }
+    char *endptr;
+    errno = 0;
+    unsigned long long count = strtoull(count_arg, &endptr, 10);
+    if (*endptr != '\0' || endptr == count_arg || count_arg[0] == '-' || errno == ERANGE || count >= VECTOR_WHOLE) {
+        print_error("Last argument in %s must be a positive integer <count>, not %s.", command, count_arg);
+        return 0;
+    }
+    *p_count = (size_t)count;
+    return 1;
+}
+
+// Reads an element of <width> bytes
+//
+// Input : A pointer to the element, its width and if its bytes are in the opposite order of the machine
+//
+// Output : Returns the element
+uint64_t read_element(const uint8_t *p_element, uint8_t width, uint8_t swap) {
+    // A fixed size memcpy is one load, and the typed value is already in the order of the machine
+    if (width == 1) {
+        return *p_element;
+    } else if (width == 2) {
+        uint16_t value;
+        memcpy(&value, p_element, 2);
+        return swap ? __builtin_bswap16(value) : value;
+    } else if (width == 4) {
+        uint32_t value;
+        memcpy(&value, p_element, 4);
+        return swap ? __builtin_bswap32(value) : value;
+    }
+    uint64_t value;
+    memcpy(&value, p_element, 8);
+    return swap ? __builtin_bswap64(value) : value;
+}
+
+// Writes an element of <width> bytes
+//
+// Input : A pointer to the element, its width, if its bytes are in the opposite order of the machine, and its value (the lowest <width> bytes)
+//
+// Output : The element is written
+void write_element(uint8_t *p_element, uint8_t width, uint8_t swap, uint64_t value) {
+    if (width == 1) {
+        *p_element = (uint8_t)value;
+    } else if (width == 2) {
+        uint16_t element = swap ? __builtin_bswap16((uint16_t)value) : (uint16_t)value;
+        memcpy(p_element, &element, 2);
+    } else if (width == 4) {
+        uint32_t element = swap ? __builtin_bswap32((uint32_t)value) : (uint32_t)value;
+        memcpy(p_element, &element, 4);
+    } else {
+        uint64_t element = swap ? __builtin_bswap64(value) : value;
+        memcpy(p_element, &element, 8);
+    }
+}
+
+// The scalar kernel, one element at a time, runs every operation in any byte order
+uint8_t elementwise_scalar(Vector_Op op, uint8_t width, uint8_t swap, uint8_t *p_dst, const uint8_t *p_src, uint64_t operand, size_t count) {
+    uint64_t mask = (width == 8) ? UINT64_MAX : (((uint64_t)1 << (8 * width)) - 1); // The bits that fit in an element
+    for (size_t i = 0; i < count; i++) {
+        uint64_t value = read_element(p_dst + i * width, width, swap);
+        uint64_t other = (op == VEC_SHL) ? 0 : read_element(p_src + i * width, width, swap);
+        switch (op) {
+            case VEC_ADD:
+                value += other;
+                break;
+            case VEC_XOR:
+                value ^= other;
+                break;
+            case VEC_AND:
+                value &= other;
+                break;
+            case VEC_OR:
+                value |= other;
+                break;
+            case VEC_SHL:
+                value <<= operand;
+                break;
+            default:
+                return 0;
+        }
+        write_element(p_dst + i * width, width, swap, value & mask);
+    }
+    return 1;
+}
+
+uint8_t reduce_scalar(Vector_Reduction reduction, uint8_t width, uint8_t swap, const uint8_t *p_src, size_t count, uint64_t *p_result) {
+    for (size_t i = 0; i < count; i++) {
+        uint64_t value = read_element(p_src + i * width, width, swap);
+        switch (reduction) {
+            case VEC_SUM:
+                *p_result += value;
+                break;
+            case VEC_MIN:
+                *p_result = (value < *p_result) ? value : *p_result;
+                break;
+            case VEC_MAX:
+                *p_result = (value > *p_result) ? value : *p_result;
+                break;
+            case VEC_POPCOUNT:
+                *p_result += (uint64_t)__builtin_popcountll(value);
+                break;
+            default:
+                return 0;
+        }
+    }
+    return 1;
+}
+
+#ifdef VECTOR_X86
+
+// The loop of one elementwise operation over the whole vectors of the range, EXPR makes the new vector of the destination
+// from a (the vector of the destination) and b (the vector of the source). The elements after the last whole vector are left for the scalar kernel
+#define ELEMENTWISE_LOOP(VECTOR, LOAD, STORE, EXPR) \
+    for (; i + sizeof(VECTOR) <= size; i += sizeof(VECTOR)) { \
+        VECTOR a = LOAD((const VECTOR*)(p_dst + i)); \
+        VECTOR b = LOAD((const VECTOR*)(p_src + i)); \
+        (void)b; /* VEC_SHL doesn't use it */ \
+        STORE((VECTOR*)(p_dst + i), EXPR); \
+    }
+
+// The SSE2 kernel, 16 bytes at a time, no unsigned min and max of elements wider than a byte
+__attribute__((target("sse2")))
+uint8_t elementwise_sse2(Vector_Op op, uint8_t width, uint8_t swap, uint8_t *p_dst, const uint8_t *p_src, uint64_t operand, size_t count) {
+    if (swap && (op == VEC_ADD || op == VEC_SHL)) { // The carries go to the other side in the other byte order, only the scalar kernel swaps
+        return 0;
+    }
+
+    size_t size = count * width, i = 0;
+    __m128i shift = _mm_set_epi64x(0, (long long)operand);
+    __m128i byte_mask = _mm_set1_epi8((char)(0xFF << (operand & 7))); // There is no shift of bytes, shift 16 bits and drop what moved into the next byte
+    switch (op) {
+        case VEC_ADD:
+            if (width == 1) ELEMENTWISE_LOOP(__m128i, _mm_loadu_si128, _mm_storeu_si128, _mm_add_epi8(a, b))
+            else if (width == 2) ELEMENTWISE_LOOP(__m128i, _mm_loadu_si128, _mm_storeu_si128, _mm_add_epi16(a, b))
+            else if (width == 4) ELEMENTWISE_LOOP(__m128i, _mm_loadu_si128, _mm_storeu_si128, _mm_add_epi32(a, b))
+            else ELEMENTWISE_LOOP(__m128i, _mm_loadu_si128, _mm_storeu_si128, _mm_add_epi64(a, b))
+            break;
+        case VEC_XOR:
+            ELEMENTWISE_LOOP(__m128i, _mm_loadu_si128, _mm_storeu_si128, _mm_xor_si128(a, b))
+            break;
+        case VEC_AND:
+            ELEMENTWISE_LOOP(__m128i, _mm_loadu_si128, _mm_storeu_si128, _mm_and_si128(a, b))
+            break;
+        case VEC_OR:
+            ELEMENTWISE_LOOP(__m128i, _mm_loadu_si128, _mm_storeu_si128, _mm_or_si128(a, b))
+            break;
+        case VEC_SHL:
+            if (width == 1) ELEMENTWISE_LOOP(__m128i, _mm_loadu_si128, _mm_storeu_si128, _mm_and_si128(_mm_sll_epi16(a, shift), byte_mask))
+            else if (width == 2) ELEMENTWISE_LOOP(__m128i, _mm_loadu_si128, _mm_storeu_si128, _mm_sll_epi16(a, shift))
+            else if (width == 4) ELEMENTWISE_LOOP(__m128i, _mm_loadu_si128, _mm_storeu_si128, _mm_sll_epi32(a, shift))
+            else ELEMENTWISE_LOOP(__m128i, _mm_loadu_si128, _mm_storeu_si128, _mm_sll_epi64(a, shift))
+            break;
+        default:
+            return 0;
+    }
+    return elementwise_scalar(op, width, swap, p_dst + i, p_src + i, operand, (size - i) / width);
+}
+
+__attribute__((target("sse2")))
+uint8_t reduce_sse2(Vector_Reduction reduction, uint8_t width, uint8_t swap, const uint8_t *p_src, size_t count, uint64_t *p_result) {
+    if ((swap && reduction != VEC_POPCOUNT) || ((reduction == VEC_MIN || reduction == VEC_MAX) && width != 1)) {
+        return 0;
+    }
+
+    size_t size = count * width, i = 0;
+    __m128i zero = _mm_setzero_si128();
+    __m128i low_16 = _mm_set1_epi32(0xFFFF), low_32 = _mm_set1_epi64x(0xFFFFFFFF);
+    uint64_t arr_lanes[2];
+    if (reduction == VEC_SUM || reduction == VEC_POPCOUNT) { // Both add into 2 lanes of 64 bits
+        __m128i sum = zero;
+        for (; i + 16 <= size; i += 16) {
+            __m128i vector = _mm_loadu_si128((const __m128i*)(p_src + i));
+            if (reduction == VEC_POPCOUNT) { // The bits of every byte are counted in place (SSE2 has no table lookup), then summed like u8
+                vector = _mm_sub_epi8(vector, _mm_and_si128(_mm_srli_epi16(vector, 1), _mm_set1_epi8(0x55)));
+                vector = _mm_add_epi8(_mm_and_si128(vector, _mm_set1_epi8(0x33)), _mm_and_si128(_mm_srli_epi16(vector, 2), _mm_set1_epi8(0x33)));
+                vector = _mm_and_si128(_mm_add_epi8(vector, _mm_srli_epi16(vector, 4)), _mm_set1_epi8(0x0F));
+                sum = _mm_add_epi64(sum, _mm_sad_epu8(vector, zero));
+            } else if (width == 1) {
+                sum = _mm_add_epi64(sum, _mm_sad_epu8(vector, zero)); // Adds every 8 bytes into the 64 bits they are in
+            } else if (width == 2) {
+                vector = _mm_add_epi32(_mm_and_si128(vector, low_16), _mm_srli_epi32(vector, 16));
+                sum = _mm_add_epi64(sum, _mm_add_epi64(_mm_and_si128(vector, low_32), _mm_srli_epi64(vector, 32)));
+            } else if (width == 4) {
+                sum = _mm_add_epi64(sum, _mm_add_epi64(_mm_and_si128(vector, low_32), _mm_srli_epi64(vector, 32)));
+            } else {
+                sum = _mm_add_epi64(sum, vector);
+            }
+        }
+        _mm_storeu_si128((__m128i*)arr_lanes, sum);
+        *p_result += arr_lanes[0] + arr_lanes[1];
+    } else if (size >= 16) { // VEC_MIN or VEC_MAX of bytes
+        __m128i best = _mm_loadu_si128((const __m128i*)p_src);
+        for (i = 16; i + 16 <= size; i += 16) {
+            __m128i vector = _mm_loadu_si128((const __m128i*)(p_src + i));
+            best = (reduction == VEC_MIN) ? _mm_min_epu8(best, vector) : _mm_max_epu8(best, vector);
+        }
+        _mm_storeu_si128((__m128i*)arr_lanes, best);
+        reduce_scalar(reduction, 1, 0, (const uint8_t*)arr_lanes, 16, p_result);
+    }
+    return reduce_scalar(reduction, width, swap, p_src + i, (size - i) / width, p_result);
+}
+
+// The AVX2 kernel, 32 bytes at a time, the same loops as the SSE2 kernel
+__attribute__((target("avx2")))
+uint8_t elementwise_avx2(Vector_Op op, uint8_t width, uint8_t swap, uint8_t *p_dst, const uint8_t *p_src, uint64_t operand, size_t count) {
+    if (swap && (op == VEC_ADD || op == VEC_SHL)) {
+        return 0;
+    }
+
+    size_t size = count * width, i = 0;
+    __m128i shift = _mm_set_epi64x(0, (long long)operand);
+    __m256i byte_mask = _mm256_set1_epi8((char)(0xFF << (operand & 7)));
+    switch (op) {
+        case VEC_ADD:
+            if (width == 1) ELEMENTWISE_LOOP(__m256i, _mm256_loadu_si256, _mm256_storeu_si256, _mm256_add_epi8(a, b))
+            else if (width == 2) ELEMENTWISE_LOOP(__m256i, _mm256_loadu_si256, _mm256_storeu_si256, _mm256_add_epi16(a, b))
+            else if (width == 4) ELEMENTWISE_LOOP(__m256i, _mm256_loadu_si256, _mm256_storeu_si256, _mm256_add_epi32(a, b))
+            else ELEMENTWISE_LOOP(__m256i, _mm256_loadu_si256, _mm256_storeu_si256, _mm256_add_epi64(a, b))
+            break;
+        case VEC_XOR:
+            ELEMENTWISE_LOOP(__m256i, _mm256_loadu_si256, _mm256_storeu_si256, _mm256_xor_si256(a, b))
+            break;
+        case VEC_AND:
+            ELEMENTWISE_LOOP(__m256i, _mm256_loadu_si256, _mm256_storeu_si256, _mm256_and_si256(a, b))
+            break;
+        case VEC_OR:
+            ELEMENTWISE_LOOP(__m256i, _mm256_loadu_si256, _mm256_storeu_si256, _mm256_or_si256(a, b))
+            break;
+        case VEC_SHL:
+            if (width == 1) ELEMENTWISE_LOOP(__m256i, _mm256_loadu_si256, _mm256_storeu_si256, _mm256_and_si256(_mm256_sll_epi16(a, shift), byte_mask))
+            else if (width == 2) ELEMENTWISE_LOOP(__m256i, _mm256_loadu_si256, _mm256_storeu_si256, _mm256_sll_epi16(a, shift))
+            else if (width == 4) ELEMENTWISE_LOOP(__m256i, _mm256_loadu_si256, _mm256_storeu_si256, _mm256_sll_epi32(a, shift))
+            else ELEMENTWISE_LOOP(__m256i, _mm256_loadu_si256, _mm256_storeu_si256, _mm256_sll_epi64(a, shift))
+            break;
+        default:
+            return 0;
+    }
+    return elementwise_scalar(op, width, swap, p_dst + i, p_src + i, operand, (size - i) / width);
+}
+
+__attribute__((target("avx2")))
+uint8_t reduce_avx2(Vector_Reduction reduction, uint8_t width, uint8_t swap, const uint8_t *p_src, size_t count, uint64_t *p_result) {
+    if (swap && reduction != VEC_POPCOUNT) {
+        return 0;
+    }
+
+    size_t size = count * width, i = 0;
+    __m256i zero = _mm256_setzero_si256();
+    __m256i low_16 = _mm256_set1_epi32(0xFFFF), low_32 = _mm256_set1_epi64x(0xFFFFFFFF);
+    uint64_t arr_lanes[4];
+    if (reduction == VEC_SUM || reduction == VEC_POPCOUNT) {
+        __m256i sum = zero;
+        // The amount of bits in every value of 4 bits, looked up 32 bytes at a time
+        __m256i bits_table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        __m256i low_4 = _mm256_set1_epi8(0x0F);
+        for (; i + 32 <= size; i += 32) {
+            __m256i vector = _mm256_loadu_si256((const __m256i*)(p_src + i));
+            if (reduction == VEC_POPCOUNT) {
+                __m256i low_bits = _mm256_shuffle_epi8(bits_table, _mm256_and_si256(vector, low_4));
+                __m256i high_bits = _mm256_shuffle_epi8(bits_table, _mm256_and_si256(_mm256_srli_epi16(vector, 4), low_4));
+                sum = _mm256_add_epi64(sum, _mm256_sad_epu8(_mm256_add_epi8(low_bits, high_bits), zero));
+            } else if (width == 1) {
+                sum = _mm256_add_epi64(sum, _mm256_sad_epu8(vector, zero));
+            } else if (width == 2) {
+                vector = _mm256_add_epi32(_mm256_and_si256(vector, low_16), _mm256_srli_epi32(vector, 16));
+                sum = _mm256_add_epi64(sum, _mm256_add_epi64(_mm256_and_si256(vector, low_32), _mm256_srli_epi64(vector, 32)));
+            } else if (width == 4) {
+                sum = _mm256_add_epi64(sum, _mm256_add_epi64(_mm256_and_si256(vector, low_32), _mm256_srli_epi64(vector, 32)));
+            } else {
+                sum = _mm256_add_epi64(sum, vector);
+            }
+        }
+        _mm256_storeu_si256((__m256i*)arr_lanes, sum);
+        *p_result += arr_lanes[0] + arr_lanes[1] + arr_lanes[2] + arr_lanes[3];
+    } else if (size >= 32) { // VEC_MIN or VEC_MAX
+        __m256i best = _mm256_loadu_si256((const __m256i*)p_src);
+        __m256i sign = _mm256_set1_epi64x(INT64_MIN); // AVX2 only compares signed 64 bits, flipping the highest bit makes the order unsigned
+        for (i = 32; i + 32 <= size; i += 32) {
+            __m256i vector = _mm256_loadu_si256((const __m256i*)(p_src + i));
+            if (width == 1) {
+                best = (reduction == VEC_MIN) ? _mm256_min_epu8(best, vector) : _mm256_max_epu8(best, vector);
+            } else if (width == 2) {
+                best = (reduction == VEC_MIN) ? _mm256_min_epu16(best, vector) : _mm256_max_epu16(best, vector);
+            } else if (width == 4) {
+                best = (reduction == VEC_MIN) ? _mm256_min_epu32(best, vector) : _mm256_max_epu32(best, vector);
+            } else {
+                __m256i best_is_bigger = _mm256_cmpgt_epi64(_mm256_xor_si256(best, sign), _mm256_xor_si256(vector, sign));
+                best = (reduction == VEC_MIN) ? _mm256_blendv_epi8(best, vector, best_is_bigger) : _mm256_blendv_epi8(vector, best, best_is_bigger);
+            }
+        }
+        _mm256_storeu_si256((__m256i*)arr_lanes, best);
+        reduce_scalar(reduction, width, 0, (const uint8_t*)arr_lanes, 32 / width, p_result);
+    }
+    return reduce_scalar(reduction, width, swap, p_src + i, (size - i) / width, p_result);
+}
+
+#endif // VECTOR_X86
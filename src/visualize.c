@@ -4,46 +4,49 @@
 //
 // Input : A pointer to the memory and the amount of arguments and the arguments
 //
-// Output : Calls the function visualize_bytes if all the arguments are valid
-void visualize_bytes_command(Memory *p_memory, int args_c, char *args[10]) {
+// Output : Calls the function visualize_bytes if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status visualize_bytes_command(Memory *p_memory, int args_c, char *args[10]) {
     if (args_c != 0) { // Might want to remove this in the future right now is here for consistency between parsers
         print_error("Wrong amount of arguments for function visualize_bytes. Expected 0 arguments but received %d arguments",args_c);
-        return;
+        return COMMAND_FAILED;
     }
     
     visualize_bytes(p_memory);
+    return COMMAND_SUCCEEDED;
 }
 
 // Shows the bytes array items as their hex format. Recommendation : Do not use over 1000 slots of memory if you want to use this function proprerly
 //
 // Input : A pointer to the memory
 //
-// Output : Prints all the items in the bytes array in the memory, based on their corresponding block as free, uninitialized, or with a value.
+// Output : Prints all the items in the bytes array in the memory, based on their corresponding block as free, or byte by byte as never written (from the shadow) or with a value.
 void visualize_bytes(Memory *p_mem) {
     // We don't really need a pointer to a memory struct, it can just be a memory struct, but its more uniform like this (with other functions)
     Memory mem = *p_mem; 
 
-    unsigned int block_index = 0; // Index in blocks array
-    int biggest_index_for_block = -1; // What index does the current block end at in the bytes array
+    BlockId next_block = mem.first_block; // Next block in the linked list
+    int64_t biggest_index_for_block = -1; // What index does the current block end at in the bytes array
     int stage_to_print; // Print __, ** or XX
     
-    for (int i = 0; i < mem.memory_size;i++) { // Loop over all the memory's bytes
+    for (int64_t i = 0; i < (int64_t)mem.memory_size;i++) { // Loop over all the memory's bytes
         
         if (i > biggest_index_for_block){ // If outside the current block update the block you are in
             
-            Block curr = mem.p_blocks[block_index]; // Increase readability
+            BlockId curr = next_block; // Increase readability
+            uint8_t state = mem.blocks.p_states[curr];
             
-            biggest_index_for_block = curr.start_index + curr.size - 1; // When does this block end in bytes array
-            block_index++; // Next block's index in blocks array
+            biggest_index_for_block = (int64_t)(mem.blocks.p_start_indices[curr] + mem.blocks.p_sizes[curr]) - 1; // When does this block end in bytes array
+            next_block = mem.blocks.p_next[curr]; // Next block in the linked list
             
-            if (curr.free) {
+            if (state & BLOCK_FREE) {
                 stage_to_print = FREE;
-            } else if (curr.uninitialized) {
-                stage_to_print = UNINITIALIZED;
             } else { 
                 stage_to_print = USED;
             }
         }
+        if (stage_to_print != FREE) { // Every byte of an allocated block was written or not on its own
+            stage_to_print = shadow_read_bits(mem.p_shadow, (size_t)i, 1) ? USED : UNINITIALIZED;
+        }
 
         switch (stage_to_print) {
             case FREE:
@@ -82,13 +85,14 @@ void print_bytes_visualization_legend() {
 //
 // Input : A pointer to the memory and the amount of arguments and the arguments
 //
-// Output : Calls the function visualize_blocks if all the arguments are valid
-void visualize_blocks_command(Memory *p_memory, int args_c, char *args[10]) {
+// Output : Calls the function visualize_blocks if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status visualize_blocks_command(Memory *p_memory, int args_c, char *args[10]) {
     if (args_c != 0){ // Might want to remove this in the future right now is here for consistency between parsers
         print_error("Wrong amount of arguments for function visualize_blocks. Expected 0 arguments but received %d arguments",args_c);
-        return;
+        return COMMAND_FAILED;
     }
     visualize_blocks(p_memory);
+    return COMMAND_SUCCEEDED;
 }
 
 // Show a list of the blocks and their metadata
@@ -100,17 +104,34 @@ void visualize_blocks(Memory *p_mem) {
     // We don't really need a pointer to a memory struct, it can just be a memory struct, but its more uniform like this (with other functions)
     Memory mem = *p_mem;
 
-    Block curr; // Increase readablity
+    BlockTable table = mem.blocks; // Increase readablity
+    int i = 0; // Position of the block in the linked list
 
     printlnf("Here is the metadata of the blocks in the memory\n");
-    for (int i = 0; i < mem.amount_of_blocks; i++){ // Print the metadata for all the blocks in the blocks array.
-        curr = mem.p_blocks[i];
-
+    for (BlockId curr = mem.first_block; curr != NO_BLOCK; curr = table.p_next[curr], i++){ // Print the metadata for all the blocks in the order they are in memory.
         printlnf("Block number: %d", i + 1);
-        printlnf(" - Size: %d",curr.size);
-        printlnf(" - Free: %s", curr.free ? "Yes":"No");
-        printlnf(" - Initialized: %s",curr.uninitialized ? "No" : "Yes");
-        printlnf(" - Start in bytes array: %d",curr.start_index);
+        printlnf(" - Size: %zu",table.p_sizes[curr]);
+        printlnf(" - Free: %s", (table.p_states[curr] & BLOCK_FREE) ? "Yes":"No");
+        size_t written = shadow_count(mem.p_shadow, table.p_start_indices[curr], table.p_sizes[curr]); // Bytes that don't hold garbage
+        if (written == table.p_sizes[curr]) {
+            printlnf(" - Initialized: Yes");
+        } else if (written == 0) {
+            printlnf(" - Initialized: No");
+        } else {
+            printlnf(" - Initialized: %zu of %zu bytes", written, table.p_sizes[curr]);
+        }
+        printlnf(" - Start in bytes array: %zu",table.p_start_indices[curr]);
+        if (table.p_states[curr] & BLOCK_REGION) { // Regions hand out their own allocations, show how much of the block they use
+            Region *p_region;
+            char *name = find_region_of_block(p_mem, curr, &p_region);
+            if (name != NULL && p_region->type == ARENA) {
+                printlnf(" - Arena %s: %zu of %zu bytes used", name, p_region->used, table.p_sizes[curr]);
+            } else if (name != NULL && p_region->type == POOL) { // The objects have no blocks of their own, so this is the only place they show up
+                printlnf(" - Pool %s: %u of %u objects of %u bytes used", name, p_region->used, p_region->count, p_region->object_size);
+            } else if (name != NULL && p_region->type == NURSERY) {
+                printlnf(" - Nursery: %zu of %zu bytes used, for allocations of up to %u bytes", p_region->used, table.p_sizes[curr], p_region->object_size);
+            }
+        }
         printlnf(""); // One line padding between Block's info
     }
 }
\ No newline at end of file
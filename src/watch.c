@@ -0,0 +1,252 @@
+#include "watch.h"
+
+#include <errno.h> // For the range errors of strtoull()
+
+// Arguments parser for the watch_add function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function watch_add if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status watch_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c < 1 || args_c > 3) {
+        print_error("Wrong amount of arguments for function watch. Expected 1 to 3 arguments but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    Pointer *p_ptr = (Pointer*)hashmap_get(p_memory->p_pointers, args[0]);
+    if (p_ptr == NULL) {
+        print_error("Could not locate pointer %s. Please create a pointer with the command new_pointer.",args[0]);
+        return COMMAND_FAILED;
+    }
+    size_t start, size;
+    if (resolve_pointer(p_memory, *p_ptr, &start, &size) == NO_BLOCK) { // Works for pointers to blocks and pointers into regions
+        return COMMAND_FAILED;
+    }
+
+    char *endptr;
+    size_t offset = 0;
+    if (args_c >= 2) {
+        errno = 0;
+        offset = strtoull(args[1], &endptr, 10);
+        if (*endptr != '\0' || endptr == args[1] || args[1][0] == '-' || errno == ERANGE || offset >= size) {
+            print_error("Second argument in watch must be an offset inside the %zu bytes of pointer %s <offset>, not %s.", size, args[0], args[1]);
+            return COMMAND_FAILED;
+        }
+    }
+    size_t length = size - offset; // The rest of the pointer if the length is left out
+    if (args_c == 3) {
+        errno = 0;
+        length = strtoull(args[2], &endptr, 10);
+        if (*endptr != '\0' || endptr == args[2] || args[2][0] == '-' || errno == ERANGE || length == 0 || length > size - offset) {
+            print_error("Third argument in watch must be a length from 1 to %zu (the bytes after the offset) <length>, not %s.", size - offset, args[2]);
+            return COMMAND_FAILED;
+        }
+    }
+
+    watch_add(p_memory, args[0], start + offset, length);
+    print_success("Watching bytes %zu to %zu (%zu bytes of pointer %s) successfully.", start + offset, start + offset + length - 1, length, args[0]);
+    return COMMAND_SUCCEEDED;
+}
+
+// Arguments parser for the watch_remove function
+//
+// Input : A pointer to the memory and the amount of arguments and the arguments
+//
+// Output : Calls the function watch_remove if all the arguments are valid, returns how the command ended (see Command_Status)
+Command_Status unwatch_command(Memory *p_memory, int args_c, char *args[10]) {
+    if (args_c != 1) {
+        print_error("Wrong amount of arguments for function unwatch. Expected 1 argument but received %d arguments",args_c);
+        return COMMAND_FAILED;
+    }
+
+    Watchpoint *p_watch = (Watchpoint*)hashmap_get(p_memory->p_watches, args[0]);
+    if (p_watch == NULL) {
+        print_error("Pointer %s has no watchpoint.", args[0]);
+        return COMMAND_FAILED;
+    }
+    uint64_t hits = p_watch->hits; // Read before it is freed
+    watch_remove(p_memory, args[0]);
+    print_success("Stopped watching pointer %s successfully, %" PRIu64 " writes touched it.", args[0], hits);
+    return COMMAND_SUCCEEDED;
+}
+
+// Sets a watchpoint on a range of bytes, a pointer has at most one (setting another one replaces it)
+//
+// Input : A pointer to the memory, the name of the pointer, the index of the first byte and how many bytes
+//
+// Output : Saves the watchpoint and turns on the bits of its pages
+void watch_add(Memory *p_memory, const char *name, size_t start, size_t size) {
+    Watchpoint *p_watch = malloc(sizeof(Watchpoint)); // Put the watchpoint on the heap (so it can be used in the hashmap)
+    if (!p_watch) {
+        fprintf(stderr, "Memory allocation failed for Watchpoint struct!\n");
+        exit(1);
+    }
+    *p_watch = (Watchpoint){.start = start, .size = size, .hits = 0};
+    hashmap_insert(p_memory->p_watches, name, p_watch, (uint8_t)1); // Replaces the old watchpoint of the pointer
+    watch_rebuild_pages(p_memory);
+}
+
+// Removes the watchpoint of a pointer
+//
+// Input : A pointer to the memory and the name of the pointer
+//
+// Output : Returns a boolean (0 or 1) if the pointer had a watchpoint or not, the page bitmap is freed with the last watchpoint
+uint8_t watch_remove(Memory *p_memory, const char *name) {
+    if (hashmap_get(p_memory->p_watches, name) == NULL) {
+        return 0;
+    }
+    hashmap_remove(p_memory->p_watches, name, (uint8_t)1);
+    watch_rebuild_pages(p_memory); // Two watchpoints can share a page, so the bits are built again instead of turned off
+    return 1;
+}
+
+// Builds the page bitmap again from the watchpoints, after one was added or removed or the memory grew
+//
+// Input : A pointer to the memory
+//
+// Output : Memory.p_watch_pages has the bits of the pages of every watchpoint, or is NULL if there are none
+void watch_rebuild_pages(Memory *p_memory) {
+    free(p_memory->p_watch_pages);
+    p_memory->p_watch_pages = NULL; // With no watchpoints, a write costs one NULL check
+
+    HashMap *p_watches = p_memory->p_watches; // Readability
+    size_t amount_of_pages = (p_memory->memory_size + WATCH_PAGE_SIZE - 1) / WATCH_PAGE_SIZE;
+    for (size_t i = 0; i < p_watches->bucket_size; i++) {
+        for (HashNode *p_node = p_watches->pp_map[i]; p_node != NULL; p_node = p_node->p_next) {
+            if (p_memory->p_watch_pages == NULL) {
+                // One bit for every page, the same layout as the shadow of the memory, so the shadow functions set and test it
+                p_memory->p_watch_pages = calloc(shadow_storage_size(amount_of_pages), 1);
+                if (!p_memory->p_watch_pages) {
+                    fprintf(stderr, "Memory allocation failed for the pages of the watchpoints!\n");
+                    exit(1);
+                }
+            }
+            Watchpoint *p_watch = (Watchpoint*)p_node->p_value;
+            size_t first_page = p_watch->start / WATCH_PAGE_SIZE;
+            size_t last_page = (p_watch->start + p_watch->size - 1) / WATCH_PAGE_SIZE;
+            shadow_set(p_memory->p_watch_pages, first_page, last_page - first_page + 1);
+        }
+    }
+}
+
+// Moves the watchpoints on bytes that moved to where the bytes are now, called by every path that moves bytes inside the memory
+//
+// Input : A pointer to the memory, the index the bytes were at, the index they are at now and how many bytes
+//
+// Output : Every watchpoint that starts in the moved bytes starts at the same offset from <new_start> (and is cut to the moved bytes)
+void watch_move(Memory *p_memory, size_t old_start, size_t new_start, size_t size) {
+    if (p_memory->p_watch_pages == NULL || old_start == new_start) { // No watchpoints, or nothing moved
+        return;
+    }
+
+    uint8_t moved = 0;
+    HashMap *p_watches = p_memory->p_watches; // Readability
+    for (size_t i = 0; i < p_watches->bucket_size; i++) {
+        for (HashNode *p_node = p_watches->pp_map[i]; p_node != NULL; p_node = p_node->p_next) {
+            Watchpoint *p_watch = (Watchpoint*)p_node->p_value;
+            if (p_watch->start < old_start || p_watch->start >= old_start + size) {
+                continue;
+            }
+            if (p_watch->start + p_watch->size > old_start + size) { // Only the start of the bytes moved (realloc to a smaller size)
+                p_watch->size = old_start + size - p_watch->start;
+            }
+            p_watch->start = p_watch->start - old_start + new_start;
+            moved = 1;
+        }
+    }
+    if (moved) {
+        watch_rebuild_pages(p_memory);
+    }
+}
+
+// Removes the watchpoints on bytes that were freed, called by every path that frees bytes
+//
+// Input : A pointer to the memory, the index of the first freed byte and how many bytes
+//
+// Output : Every watchpoint on the freed bytes is removed (after a report), or cut to the bytes of it that are still allocated
+void watch_free(Memory *p_memory, size_t start, size_t size) {
+    if (p_memory->p_watch_pages == NULL || size == 0) { // No watchpoints
+        return;
+    }
+
+    uint8_t changed = 0;
+    HashMap *p_watches = p_memory->p_watches; // Readability
+    for (size_t i = 0; i < p_watches->bucket_size; i++) {
+        HashNode *p_next;
+        for (HashNode *p_node = p_watches->pp_map[i]; p_node != NULL; p_node = p_next) {
+            p_next = p_node->p_next; // Removing the node frees it
+            Watchpoint *p_watch = (Watchpoint*)p_node->p_value;
+            size_t watch_end = p_watch->start + p_watch->size;
+            if (watch_end <= start || p_watch->start >= start + size) { // Not freed
+                continue;
+            }
+            changed = 1;
+            if (p_watch->start < start) { // The bytes before the freed ones are still allocated (realloc to a smaller size)
+                p_watch->size = start - p_watch->start;
+            } else if (watch_end > start + size) {
+                p_watch->size = watch_end - (start + size);
+                p_watch->start = start + size;
+            } else {
+                printf("\033[4;38;5;136m[WATCH]\033[24m\033[38;5;220m "); // Same as the reports of watch_report
+                printf("The watched bytes of pointer %s were freed, the watchpoint was removed after %" PRIu64 " writes.\033[0m\n", p_node->p_key, p_watch->hits);
+                hashmap_remove(p_watches, p_node->p_key, (uint8_t)1);
+            }
+        }
+    }
+    if (changed) {
+        watch_rebuild_pages(p_memory);
+    }
+}
+
+// Checks a write of a command against the watchpoints, called by every command that writes bytes after it wrote them
+//
+// Input : A pointer to the memory, the index of the first byte that was written, how many bytes and the name of the command
+//
+// Output : Reports the watchpoints the write touched (nothing at all is done if no watched page was written)
+void watch_write(Memory *p_memory, size_t start, size_t size, const char *p_command) {
+    const uint64_t *p_pages = p_memory->p_watch_pages; // Readability
+    if (p_pages == NULL || size == 0) { // No watchpoints
+        return;
+    }
+
+    size_t first_page = start / WATCH_PAGE_SIZE;
+    size_t last_page = (start + size - 1) / WATCH_PAGE_SIZE;
+    if (first_page == last_page) { // Every write of set_val and store, one bit test
+        if (!((p_pages[first_page / 64] >> (first_page % 64)) & 1)) {
+            return;
+        }
+    } else if (shadow_count(p_pages, first_page, last_page - first_page + 1) == 0) { // A word of the bitmap (64 pages) at a time
+        return;
+    }
+    watch_report(p_memory, start, size, p_command); // Only a watched page was written, the watchpoints themselves are checked now
+}
+
+// Prints a report for every watchpoint that a write touched
+//
+// Input : A pointer to the memory, the index of the first byte that was written, how many bytes and the name of the command
+//
+// Output : Prints the bytes the write changed in every watched range it touched, and counts the hits
+void watch_report(Memory *p_memory, size_t start, size_t size, const char *p_command) {
+    HashMap *p_watches = p_memory->p_watches; // Readability
+    for (size_t i = 0; i < p_watches->bucket_size; i++) {
+        for (HashNode *p_node = p_watches->pp_map[i]; p_node != NULL; p_node = p_node->p_next) {
+            Watchpoint *p_watch = (Watchpoint*)p_node->p_value;
+            size_t first = (start > p_watch->start) ? start : p_watch->start; // The watched bytes that were written
+            size_t end = (start + size < p_watch->start + p_watch->size) ? start + size : p_watch->start + p_watch->size;
+            if (first >= end) { // Same page, but not the same bytes
+                continue;
+            }
+            p_watch->hits++;
+
+            printf("\033[4;38;5;136m[WATCH]\033[24m\033[38;5;220m "); // Yellow prefix and text, not counted as a success or an error of the command
+            printf("%s wrote %zu watched bytes of pointer %s, at %zu to %zu:", p_command, end - first, p_node->p_key, first, end - 1);
+            for (size_t j = first; j < end && j < first + WATCH_SHOWN_BYTES; j++) {
+                printf(" %02X", p_memory->p_bytes[j]);
+            }
+            if (end - first > WATCH_SHOWN_BYTES) {
+                printf(" ...");
+            }
+            printf("\033[0m\n");
+        }
+    }
+}
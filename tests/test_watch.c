@@ -0,0 +1,224 @@
+#include "general_management.h"
+
+// Tests for the watchpoints (see watch.h), that they follow their bytes when they move and are removed when they are freed.
+// Built and run with make test
+
+int amount_of_failures = 0;
+
+// Checks a condition of a test
+//
+// Input : The condition, and the test and the condition as strings for the message
+//
+// Output : Prints a message and counts the failure if the condition is false
+void check(uint8_t passed, const char *p_test, const char *p_condition) {
+    if (!passed) {
+        printf("FAILED %s: %s\n", p_test, p_condition);
+        amount_of_failures++;
+    }
+}
+
+// Checks a condition inside a test function, with the name of the function and the condition in the message
+#define CHECK(condition) check((condition), __func__, #condition)
+
+// Creates a heap backed memory with one free block, like main does
+//
+// Input : A pointer to the memory to initialize and its size
+//
+// Output : The memory is ready for my_malloc, with its own hashmaps for the pointers, the regions and the watchpoints
+void init_test_memory(Memory *p_memory, size_t size) {
+    size_t capacity = block_table_capacity(size);
+    size_t block_map_size = (size + BLOCK_MAP_PAGE_SIZE - 1) / BLOCK_MAP_PAGE_SIZE;
+    HashMap *p_maps = malloc(3 * sizeof(HashMap));
+    void *p_storage = malloc(block_table_storage_size(capacity));
+    uint8_t *p_bytes = malloc(size);
+    BlockId *p_block_map = calloc(block_map_size, sizeof(BlockId));
+    uint64_t *p_shadow = calloc(shadow_storage_size(size), 1);
+    Pointer **pp_pointer_index = calloc((size + POINTER_INDEX_PAGE_SIZE - 1) / POINTER_INDEX_PAGE_SIZE, sizeof(Pointer*));
+    if (!p_maps || !p_storage || !p_bytes || !p_block_map || !p_shadow || !pp_pointer_index) {
+        fprintf(stderr, "Memory allocation failed for the test memory!\n");
+        exit(1);
+    }
+    p_maps[0] = init_hashmap(10);
+    p_maps[1] = init_hashmap(10);
+    p_maps[2] = init_hashmap(10);
+
+    *p_memory = (Memory){
+        .p_bytes = p_bytes,
+        .first_block = 0,
+        .free_slots = NO_BLOCK,
+        .amount_of_used_slots = 1,
+        .block_capacity = capacity,
+        .p_shadow = p_shadow,
+        .p_block_map = p_block_map,
+        .pp_pointer_index = pp_pointer_index,
+        .amount_of_blocks = 1,
+        .memory_size = size,
+        .p_pointers = &p_maps[0],
+        .p_regions = &p_maps[1],
+        .p_watches = &p_maps[2],
+        .p_watch_pages = NULL,
+        .backing = HEAP_BACKED,
+        .allocator = BEST_FIT,
+        .bulk_kernels = BULK_SCALAR,
+        .next_fit_rover = NO_BLOCK
+    };
+    init_block_table(&p_memory->blocks, p_storage, capacity);
+    p_memory->blocks.p_sizes[0] = size;
+    p_memory->blocks.p_start_indices[0] = 0;
+    p_memory->blocks.p_prev[0] = NO_BLOCK;
+    p_memory->blocks.p_next[0] = NO_BLOCK;
+    p_memory->blocks.p_prev_free[0] = NO_BLOCK;
+    p_memory->blocks.p_next_free[0] = NO_BLOCK;
+    p_memory->blocks.p_states[0] = BLOCK_FREE;
+    for (int i = 0; i < AMOUNT_OF_SIZE_CLASSES; i++) {
+        p_memory->arr_free_bins[i] = NO_BLOCK;
+    }
+    block_map_insert(p_memory, 0);
+    free_bins_insert(p_memory, 0);
+}
+
+// Frees everything init_test_memory allocated
+//
+// Input : A pointer to the memory
+//
+// Output : The memory can't be used anymore
+void free_test_memory(Memory *p_memory) {
+    hashmap_free(p_memory->p_pointers);
+    hashmap_free(p_memory->p_regions);
+    hashmap_free(p_memory->p_watches);
+    free(p_memory->p_pointers); // The start of the array of the three hashmaps
+    free(p_memory->p_watch_pages);
+    free(p_memory->blocks.p_sizes); // The start of the storage of the block table
+    free(p_memory->p_bytes);
+    free(p_memory->p_block_map);
+    free(p_memory->p_shadow);
+    free(p_memory->pp_pointer_index);
+}
+
+// Declares a pointer and allocates a block for it, like the new_pointer and malloc commands
+//
+// Input : A pointer to the memory, the name of the pointer and how many bytes
+//
+// Output : Returns the pointer struct, which is in Memory.p_pointers and the pointer index (so compact and defrag move it)
+Pointer *test_malloc(Memory *p_memory, const char *name, size_t size) {
+    Pointer *p_ptr = malloc(sizeof(Pointer));
+    if (!p_ptr) {
+        fprintf(stderr, "Memory allocation failed for Pointer struct!\n");
+        exit(1);
+    }
+    *p_ptr = (Pointer){.start_index = -1};
+    hashmap_insert(p_memory->p_pointers, name, p_ptr, (uint8_t)1);
+    my_malloc(p_memory, size, p_ptr);
+    pointer_index_update(p_memory, p_ptr);
+    return p_ptr;
+}
+
+// Frees the block of a pointer and the pointer, like the free command
+//
+// Input : A pointer to the memory and the name of the pointer
+//
+// Output : The block is free and the pointer is not in Memory.p_pointers
+void test_free(Memory *p_memory, const char *name) {
+    Pointer *p_ptr = (Pointer*)hashmap_get(p_memory->p_pointers, name);
+    my_free(p_memory, &p_ptr);
+    pointer_index_remove(p_memory, p_ptr);
+    hashmap_remove(p_memory->p_pointers, name, (uint8_t)1);
+}
+
+// A watchpoint moves with its block when compact moves the block, and still sees the writes to it
+void test_watch_compact(void) {
+    Memory memory;
+    init_test_memory(&memory, 1000);
+    test_malloc(&memory, "a", 10);
+    Pointer *p_b = test_malloc(&memory, "b", 10);
+    watch_add(&memory, "b", (size_t)p_b->start_index, 10);
+
+    test_free(&memory, "a");
+    compact(&memory);
+    Watchpoint *p_watch = (Watchpoint*)hashmap_get(memory.p_watches, "b");
+    CHECK(p_b->start_index == 0);
+    CHECK(p_watch != NULL && p_watch->start == 0 && p_watch->size == 10);
+
+    set_val(&memory, 7, *p_b);
+    CHECK(p_watch != NULL && p_watch->hits == 1);
+    free_test_memory(&memory);
+}
+
+// A watchpoint and the pointers into a block move with it when a defragmentation step moves the block, and only while the budget allows
+void test_watch_defrag(void) {
+    Memory memory;
+    init_test_memory(&memory, 1000);
+    test_malloc(&memory, "a", 300);
+    Pointer *p_b = test_malloc(&memory, "b", 10);
+    Pointer *p_c = test_malloc(&memory, "c", 400);
+    test_malloc(&memory, "e", 30);
+    Pointer *p_d = test_malloc(&memory, "d", 20);
+    watch_add(&memory, "b", (size_t)p_b->start_index, 10);
+
+    test_free(&memory, "a");
+    test_free(&memory, "e");
+    memory.defrag_budget = 100;
+    defrag_step(&memory); // b moves over the gap, c is bigger than the budget so the gap after b stays and d moves over the next one
+    Watchpoint *p_watch = (Watchpoint*)hashmap_get(memory.p_watches, "b");
+    CHECK(p_b->start_index == 0);
+    CHECK(p_watch != NULL && p_watch->start == 0 && p_watch->size == 10);
+    CHECK(p_c->start_index == 310);
+    CHECK(p_d->start_index == 710); // From 740
+    CHECK(memory.defrag_position == memory.memory_size); // Nothing left that fits in the budget
+
+    set_val(&memory, 7, *p_b);
+    CHECK(p_watch != NULL && p_watch->hits == 1);
+    test_free(&memory, "b"); // Before the position, so the next step looks again
+    CHECK(memory.defrag_position == 0);
+    free_test_memory(&memory);
+}
+
+// A watchpoint moves with the bytes that realloc copies (a hit), and is cut when realloc frees the end of the block
+void test_watch_realloc(void) {
+    Memory memory;
+    init_test_memory(&memory, 1000);
+    Pointer *p_c = test_malloc(&memory, "c", 10);
+    test_malloc(&memory, "d", 10); // So c can't grow in place
+    watch_add(&memory, "c", (size_t)p_c->start_index + 2, 6);
+
+    my_realloc(&memory, 100, p_c);
+    pointer_index_update(&memory, p_c);
+    Watchpoint *p_watch = (Watchpoint*)hashmap_get(memory.p_watches, "c");
+    CHECK(p_c->start_index == 20);
+    CHECK(p_watch != NULL && p_watch->start == 22 && p_watch->size == 6);
+    CHECK(p_watch != NULL && p_watch->hits == 1); // The copy of the bytes
+
+    my_realloc(&memory, 5, p_c); // In place, the bytes after the first 5 are freed
+    CHECK(p_watch != NULL && p_watch->start == 22 && p_watch->size == 3);
+    free_test_memory(&memory);
+}
+
+// A watchpoint is removed with its bytes, so a block allocated there later is not reported for the freed pointer
+void test_watch_free(void) {
+    Memory memory;
+    init_test_memory(&memory, 1000);
+    Pointer *p_a = test_malloc(&memory, "a", 10);
+    watch_add(&memory, "a", (size_t)p_a->start_index, 10);
+
+    test_free(&memory, "a");
+    CHECK(hashmap_get(memory.p_watches, "a") == NULL);
+    CHECK(memory.p_watch_pages == NULL); // The last watchpoint, writes check nothing again
+
+    Pointer *p_c = test_malloc(&memory, "c", 10);
+    watch_add(&memory, "other", 500, 10); // In the same page as c, but not on its bytes
+    set_val(&memory, 7, *p_c);
+    Watchpoint *p_watch = (Watchpoint*)hashmap_get(memory.p_watches, "other");
+    CHECK(p_watch != NULL && p_watch->hits == 0);
+    free_test_memory(&memory);
+}
+
+int main() {
+    test_watch_compact();
+    test_watch_defrag();
+    test_watch_realloc();
+    test_watch_free();
+    if (amount_of_failures == 0) {
+        printf("All the watchpoint tests passed.\n");
+    }
+    return amount_of_failures != 0;
+}